@@ -0,0 +1,452 @@
+#include <benchmark/benchmark.h>
+#include "Async/Parallel.h"
+#include "Async/Task.h"
+#include "Async/WhenAll.h"
+#include "time/FrameGraph.h"
+#include "time/FrameScheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kSpawnDepth = 12;
+constexpr std::int64_t kJobsPerTree = (std::int64_t{1} << (kSpawnDepth + 1)) - 1;
+
+/**
+ * @brief Reference pool mirroring the pre work-stealing scheduler: one mutex-guarded FIFO and a
+ *        condition variable shared by every worker.
+ */
+class GlobalQueuePool {
+public:
+    explicit GlobalQueuePool(std::size_t workerCount) {
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            m_threads.emplace_back([this]() { run(); });
+        }
+    }
+
+    ~GlobalQueuePool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_running = false;
+        }
+        m_cv.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void enqueue(std::function<void()> job) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.emplace_back(std::move(job));
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this]() { return !m_running || !m_jobs.empty(); });
+                if (!m_running) {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_jobs;
+    bool m_running{true};
+    std::vector<std::thread> m_threads;
+};
+
+struct TreeCounter {
+    std::atomic<std::int64_t> remaining{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    // The last decrement happens under the lock, so wait() cannot see zero, return and destroy
+    // the counter before notify_all is done with it.
+    void complete_one() {
+        auto current = remaining.load(std::memory_order_relaxed);
+        while (current > 1) {
+            if (remaining.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel,
+                                                std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        std::lock_guard lock(mutex);
+        remaining.store(0, std::memory_order_release);
+        cv.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [this]() { return remaining.load(std::memory_order_acquire) == 0; });
+    }
+};
+
+void SpawnGlobal(GlobalQueuePool& pool, TreeCounter& counter, int depth) {
+    if (depth > 0) {
+        for (int i = 0; i < 2; ++i) {
+            pool.enqueue([&pool, &counter, depth]() { SpawnGlobal(pool, counter, depth - 1); });
+        }
+    }
+    counter.complete_one();
+}
+
+void SpawnStealing(soul::async::TaskScheduler& scheduler, TreeCounter& counter, int depth) {
+    if (depth > 0) {
+        for (int i = 0; i < 2; ++i) {
+            scheduler.run_async([&scheduler, &counter, depth]() { SpawnStealing(scheduler, counter, depth - 1); });
+        }
+    }
+    counter.complete_one();
+}
+
+soul::async::Task<int> ImmediateValue(int value) {
+    co_return value;
+}
+
+soul::async::Task<int> AwaitChain(int depth) {
+    if (depth == 0) {
+        co_return 1;
+    }
+    co_return 1 + co_await AwaitChain(depth - 1);
+}
+
+// Mirrors AsyncFileManager::read -> ThreadPoolAsyncFileIO::read -> run_async.
+soul::async::Task<int> OffloadedLeaf(soul::async::TaskScheduler& scheduler) {
+    co_return co_await scheduler.run_async([]() { return 1; });
+}
+
+soul::async::Task<int> OffloadedChain(soul::async::TaskScheduler& scheduler) {
+    co_return co_await OffloadedLeaf(scheduler);
+}
+
+// The pre-timer-wheel way of delaying a coroutine: park a worker in sleep_for.
+soul::async::Task<void> SleepOnWorker(soul::async::TaskScheduler& scheduler, std::chrono::milliseconds delay) {
+    auto sleep = scheduler.run_async([delay]() { std::this_thread::sleep_for(delay); });
+    co_await sleep;
+}
+
+soul::async::Task<void> SleepOnTimerWheel(soul::async::TaskScheduler& scheduler, std::chrono::milliseconds delay) {
+    co_await scheduler.sleep_for(delay);
+}
+
+} // namespace
+
+// Recursive fan-out: every job spawns two children, stressing the submission path from workers.
+static void BM_GlobalQueueSpawnTree(benchmark::State& state) {
+    GlobalQueuePool pool(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        TreeCounter counter;
+        counter.remaining.store(kJobsPerTree);
+        pool.enqueue([&]() { SpawnGlobal(pool, counter, kSpawnDepth); });
+        counter.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * kJobsPerTree);
+}
+BENCHMARK(BM_GlobalQueueSpawnTree)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
+
+static void BM_WorkStealingSpawnTree(benchmark::State& state) {
+    soul::async::TaskScheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        TreeCounter counter;
+        counter.remaining.store(kJobsPerTree);
+        scheduler.run_async([&]() { SpawnStealing(scheduler, counter, kSpawnDepth); });
+        counter.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * kJobsPerTree);
+}
+BENCHMARK(BM_WorkStealingSpawnTree)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
+
+// Submission cost for a job capturing a shared_ptr plus a small payload, the shape produced by
+// run_async. std::function heap-allocates such captures; detail::Job keeps them inline.
+static void BM_StdFunctionJobSubmit(benchmark::State& state) {
+    auto shared = std::make_shared<int>(0);
+    std::deque<std::function<void()>> queue;
+    for (auto _ : state) {
+        queue.emplace_back([shared, a = std::uint64_t{1}, b = std::uint64_t{2}]() { *shared += static_cast<int>(a + b); });
+        queue.front()();
+        queue.pop_front();
+    }
+}
+BENCHMARK(BM_StdFunctionJobSubmit);
+
+static void BM_InlineJobSubmit(benchmark::State& state) {
+    auto shared = std::make_shared<int>(0);
+    soul::async::detail::JobStoragePool pool;
+    std::deque<soul::async::detail::Job> queue;
+    for (auto _ : state) {
+        queue.emplace_back([shared, a = std::uint64_t{1}, b = std::uint64_t{2}]() { *shared += static_cast<int>(a + b); }, pool);
+        queue.front()();
+        queue.pop_front();
+    }
+}
+BENCHMARK(BM_InlineJobSubmit);
+
+static void BM_RunAsyncRoundTrip(benchmark::State& state) {
+    soul::async::TaskScheduler scheduler(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scheduler.run_async([]() { return 1; }).get());
+    }
+}
+BENCHMARK(BM_RunAsyncRoundTrip)->UseRealTime();
+
+// Create, run and destroy a coroutine on the calling thread; frame and state come from the pools.
+static void BM_CoroutineCreateAndGet(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ImmediateValue(1).get());
+    }
+}
+BENCHMARK(BM_CoroutineCreateAndGet);
+
+static void BM_CoroutineAwaitChain(benchmark::State& state) {
+    const auto depth = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AwaitChain(depth).get());
+    }
+    state.SetItemsProcessed(state.iterations() * (depth + 1));
+}
+BENCHMARK(BM_CoroutineAwaitChain)->Arg(8)->Arg(64);
+
+// One queue hop per chain: the inner coroutines are entered by symmetric transfer and the
+// run_async completion resumes them directly on the worker.
+static void BM_OffloadedAwaitChain(benchmark::State& state) {
+    soul::async::TaskScheduler scheduler(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OffloadedChain(scheduler).get());
+    }
+}
+BENCHMARK(BM_OffloadedAwaitChain)->UseRealTime();
+
+// Latency of a single frame-style job submitted behind a burst of bulk jobs. Arg 0 submits it on
+// the normal lane alongside the burst (FIFO behaviour); Arg 1 uses the high lane.
+static void BM_FrameJobLatencyBehindBulkBurst(benchmark::State& state) {
+    constexpr int kBurst = 256;
+    const bool useHighLane = state.range(0) != 0;
+    soul::async::TaskScheduler scheduler(2);
+    const auto burstPriority = useHighLane ? soul::async::TaskPriority::Low : soul::async::TaskPriority::Normal;
+    const auto framePriority = useHighLane ? soul::async::TaskPriority::High : soul::async::TaskPriority::Normal;
+
+    for (auto _ : state) {
+        std::vector<soul::async::Task<void>> burst;
+        burst.reserve(kBurst);
+        for (int i = 0; i < kBurst; ++i) {
+            burst.push_back(scheduler.run_async(burstPriority, []() {
+                const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+                while (std::chrono::steady_clock::now() < until) {
+                }
+            }));
+        }
+
+        const auto submitted = std::chrono::steady_clock::now();
+        const auto started = scheduler.run_async(framePriority, []() { return std::chrono::steady_clock::now(); }).get();
+        state.SetIterationTime(std::chrono::duration<double>(started - submitted).count());
+
+        for (auto& task : burst) {
+            task.get();
+        }
+    }
+}
+BENCHMARK(BM_FrameJobLatencyBehindBulkBurst)->Arg(0)->Arg(1)->UseManualTime()->Iterations(50);
+
+// Wall time for 64 coroutines that each wait 1 ms on a two-worker pool. Arg 0 blocks a worker per
+// sleeper; Arg 1 parks them in the scheduler's timer wheel.
+static void BM_ConcurrentSleepers(benchmark::State& state) {
+    constexpr int kSleepers = 64;
+    constexpr auto kDelay = std::chrono::milliseconds(1);
+    const bool useTimerWheel = state.range(0) != 0;
+    soul::async::TaskScheduler scheduler(2);
+
+    for (auto _ : state) {
+        std::vector<soul::async::Task<void>> sleepers;
+        sleepers.reserve(kSleepers);
+        for (int i = 0; i < kSleepers; ++i) {
+            sleepers.push_back(scheduler.schedule(useTimerWheel ? SleepOnTimerWheel(scheduler, kDelay)
+                                                                : SleepOnWorker(scheduler, kDelay)));
+        }
+        for (auto& sleeper : sleepers) {
+            sleeper.get();
+        }
+    }
+}
+BENCHMARK(BM_ConcurrentSleepers)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Sorting one million ints: Arg 0 is std::sort on the calling thread, Arg 1 parallel_sort on a
+// hardware-sized pool.
+static void BM_SortMillionInts(benchmark::State& state) {
+    const bool useParallel = state.range(0) != 0;
+    soul::async::TaskScheduler scheduler;
+    std::vector<int> source(1 << 20);
+    std::uint32_t seed = 12345;
+    for (auto& value : source) {
+        seed = seed * 1664525u + 1013904223u;
+        value = static_cast<int>(seed >> 1);
+    }
+
+    std::vector<int> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = source;
+        state.ResumeTiming();
+        if (useParallel) {
+            soul::async::parallel::parallel_sort(scheduler, values.begin(), values.end());
+        } else {
+            std::sort(values.begin(), values.end());
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+BENCHMARK(BM_SortMillionInts)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Fan out 64 small jobs and join them. Arg 0 joins from a coroutine by awaiting each task in turn;
+// Arg 1 uses when_all, where the last child resumes the joiner.
+static void BM_FanOutJoin(benchmark::State& state) {
+    constexpr int kChildren = 64;
+    const bool useWhenAll = state.range(0) != 0;
+    soul::async::TaskScheduler scheduler(2);
+
+    auto joiner = [&]() -> soul::async::Task<int> {
+        std::vector<soul::async::Task<int>> children;
+        children.reserve(kChildren);
+        for (int i = 0; i < kChildren; ++i) {
+            children.push_back(scheduler.run_async([i]() { return i; }));
+        }
+        int sum = 0;
+        if (useWhenAll) {
+            auto join = soul::async::when_all(std::move(children));
+            for (int value : co_await join) {
+                sum += value;
+            }
+        } else {
+            for (auto& child : children) {
+                sum += co_await child;
+            }
+        }
+        co_return sum;
+    };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(joiner().get());
+    }
+}
+BENCHMARK(BM_FanOutJoin)->Arg(0)->Arg(1)->UseRealTime();
+
+// One frame of 200 small jobs in 20 chains of 10. Arg 0 rebuilds it every frame through
+// FrameScheduler (a coroutine and name lookup per job); Arg 1 replays a compiled FrameGraph.
+static void BM_FrameReplay(benchmark::State& state) {
+    constexpr int kChains = 20;
+    constexpr int kLength = 10;
+    const bool useGraph = state.range(0) != 0;
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    std::atomic_int work{0};
+
+    if (useGraph) {
+        soul::time::FrameGraph::Builder builder;
+        for (int chain = 0; chain < kChains; ++chain) {
+            soul::time::FrameGraph::NodeId previous = 0;
+            for (int step = 0; step < kLength; ++step) {
+                const auto node = builder.add("job" + std::to_string(chain * kLength + step), [&work] {
+                    work.fetch_add(1, std::memory_order_relaxed);
+                });
+                if (step > 0) {
+                    builder.depends_on(node, previous);
+                }
+                previous = node;
+            }
+        }
+        auto graph = builder.compile(scheduler);
+        for (auto _ : state) {
+            graph.execute();
+        }
+    } else {
+        soul::time::FrameScheduler frame(scheduler);
+        auto job = [](std::atomic_int& counter) -> soul::async::Task<void> {
+            counter.fetch_add(1, std::memory_order_relaxed);
+            co_return;
+        };
+        for (auto _ : state) {
+            for (int chain = 0; chain < kChains; ++chain) {
+                soul::async::TaskToken previous{};
+                for (int step = 0; step < kLength; ++step) {
+                    const std::array dependencies{previous};
+                    const auto dependencySpan = step > 0 ? std::span<const soul::async::TaskToken>(dependencies)
+                                                         : std::span<const soul::async::TaskToken>();
+                    previous = frame.schedule("job" + std::to_string(chain * kLength + step), job(work), dependencySpan).token;
+                }
+            }
+            frame.wait_for_all();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kChains * kLength);
+}
+BENCHMARK(BM_FrameReplay)->Arg(0)->Arg(1)->UseRealTime();
+
+// Ping-pong between the calling thread and the pool: each iteration submits one job and waits for
+// it, so the pool is idle whenever a job arrives. Arg 0 parks idle workers at once (a wake-up
+// call per job); Arg 1 uses the default spin-then-park policy.
+static void BM_PingPong(benchmark::State& state) {
+    soul::async::SchedulerOptions options;
+    options.workerCount = 2;
+    if (state.range(0) == 0) {
+        options.parking.spinRounds = 0;
+        options.parking.yieldRounds = 0;
+    }
+    soul::async::TaskScheduler scheduler(options);
+    int value = 0;
+    for (auto _ : state) {
+        value = scheduler.run_async([value]() { return value + 1; }).get();
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PingPong)->Arg(0)->Arg(1)->UseRealTime();
+
+// Submit 10k small jobs from outside the pool and join them. Arg 0 calls run_async per job (a
+// lock and a wake-up check each); Arg 1 publishes them all with run_async_bulk.
+static void BM_BulkSubmit(benchmark::State& state) {
+    constexpr std::size_t kJobs = 10000;
+    const bool bulk = state.range(0) != 0;
+    soul::async::TaskScheduler scheduler(2);
+    std::atomic_size_t work{0};
+    auto job = [&work](std::size_t index) { work.fetch_add(index, std::memory_order_relaxed); };
+
+    for (auto _ : state) {
+        std::vector<soul::async::Task<void>> tasks;
+        if (bulk) {
+            tasks = scheduler.run_async_bulk(kJobs, job);
+        } else {
+            tasks.reserve(kJobs);
+            for (std::size_t i = 0; i < kJobs; ++i) {
+                tasks.push_back(scheduler.run_async([&job, i]() { job(i); }));
+            }
+        }
+        for (auto& task : tasks) {
+            task.get();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kJobs);
+}
+BENCHMARK(BM_BulkSubmit)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
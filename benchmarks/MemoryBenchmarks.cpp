@@ -1,11 +1,85 @@
 #include <benchmark/benchmark.h>
 #include "Memory/Core/PoolAllocator.h"
 #include "Memory/Core/ArenaAllocator.h"
+#include "Memory/Core/MemoryAllocator.h"
+#include "Memory/Core/MemoryManager.h"
+#include "Memory/Core/StatisticsMemoryManager.h"
+#include <array>
 #include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 using namespace Memory::Core;
 
+namespace {
+
+// Reference tracker mirroring the pre-sharding MemoryManager: one mutex around one map.
+class GlobalLockTracker : public IMemoryManager {
+public:
+    void registerAllocation(void* ptr, size_t size, MemoryTag tag) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        allocations_[ptr] = {size, tag};
+    }
+    void unregisterAllocation(void* ptr) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        allocations_.erase(ptr);
+    }
+    void reportLeaks() override {}
+    size_t getTotalAllocated() override { return 0; }
+    size_t getAllocationCount() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return allocations_.size();
+    }
+    size_t getAllocationSize(void*) override { return 0; }
+    size_t getAllocatedByTag(MemoryTag tag) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t sum = 0;
+        for (const auto& [_, info] : allocations_) {
+            if (info.tag == tag) {
+                sum += info.size;
+            }
+        }
+        return sum;
+    }
+    MemoryStatistics snapshot() override { return {}; }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<void*, AllocationInfo> allocations_;
+};
+
+// Reference allocator mirroring MemoryAllocator before the thread cache: the global heap and one
+// tracking call per block.
+template<typename T>
+struct UncachedAllocator {
+    using value_type = T;
+
+    explicit UncachedAllocator(IMemoryManager& manager) noexcept : manager(&manager) {}
+    template<typename U>
+    UncachedAllocator(const UncachedAllocator<U>& other) noexcept : manager(other.manager) {}
+
+    T* allocate(std::size_t n) {
+        T* ptr = static_cast<T*>(::operator new(n * sizeof(T)));
+        manager->registerAllocation(ptr, n * sizeof(T), SOUL_MEMORY_TAG("Uncached"));
+        return ptr;
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        manager->unregisterAllocation(ptr, n * sizeof(T), SOUL_MEMORY_TAG("Uncached"));
+        ::operator delete(ptr);
+    }
+    bool operator==(const UncachedAllocator& other) const noexcept { return manager == other.manager; }
+
+    IMemoryManager* manager;
+};
+
+GlobalLockTracker g_globalLockTracker;
+MemoryManager g_shardedTracker;
+StatisticsMemoryManager g_statisticsTracker;
+
+} // namespace
+
 static void BM_PoolAllocatorAllocateDeallocate(benchmark::State& state) {
     PoolAllocator<std::uint32_t, 1024> allocator;
     for (auto _ : state) {
@@ -46,8 +120,13 @@ static void BM_PoolAllocatorBatch(benchmark::State& state) {
 }
 BENCHMARK(BM_PoolAllocatorBatch);
 
+// 1024 small allocations per frame, then reset.
+// Arg 0 uses a fixed 64 KiB arena sized for the worst frame; Arg 1 a chained arena that starts at
+// 1 KiB, grows on the first frame and reuses its retained blocks afterwards.
 static void BM_ArenaAllocatorLinear(benchmark::State& state) {
-    ArenaAllocator arena(64 * 1024);
+    const bool chained = state.range(0) == 1;
+    ArenaAllocator arena(chained ? 1024 : 64 * 1024, SOUL_MEMORY_TAG("ArenaAllocator"),
+                         chained ? ArenaGrowth::Chained : ArenaGrowth::Fixed);
 
     for (auto _ : state) {
         arena.reset();
@@ -57,5 +136,100 @@ static void BM_ArenaAllocatorLinear(benchmark::State& state) {
             benchmark::DoNotOptimize(ptr);
         }
     }
+    state.counters["capacity"] = static_cast<double>(arena.capacity());
+}
+BENCHMARK(BM_ArenaAllocatorLinear)->Arg(0)->Arg(1);
+
+// Scoped temporaries inside a frame: 16 scopes of 64 allocations, each rewound on exit.
+static void BM_ArenaScopedRewind(benchmark::State& state) {
+    ArenaAllocator arena(4096, SOUL_MEMORY_TAG("ArenaAllocator"), ArenaGrowth::Chained);
+
+    for (auto _ : state) {
+        arena.reset();
+        for (int scope = 0; scope < 16; ++scope) {
+            ScopedArena scratch(arena);
+            for (int i = 0; i < 64; ++i) {
+                benchmark::DoNotOptimize(scratch.create<std::uint64_t>(static_cast<std::uint64_t>(i)));
+            }
+        }
+    }
+}
+BENCHMARK(BM_ArenaScopedRewind);
+
+// Every thread allocates and frees batches of small blocks through a tracking MemoryAllocator.
+// Arg 0 tracks them in one globally locked map; Arg 1 in MemoryManager's address-hashed shards;
+// Arg 2 only counts them, in StatisticsMemoryManager.
+static void BM_TrackedAllocationThreads(benchmark::State& state) {
+    const std::array<IMemoryManager*, 3> managers{&g_globalLockTracker, &g_shardedTracker, &g_statisticsTracker};
+    IMemoryManager& manager = *managers[static_cast<std::size_t>(state.range(0))];
+    MemoryAllocator<std::uint64_t> allocator(manager);
+    std::array<std::uint64_t*, 64> blocks{};
+
+    for (auto _ : state) {
+        for (auto& block : blocks) {
+            block = allocator.allocate(4);
+            benchmark::DoNotOptimize(block);
+        }
+        for (auto* block : blocks) {
+            allocator.deallocate(block, 4);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(blocks.size()));
+}
+BENCHMARK(BM_TrackedAllocationThreads)->Arg(0)->Arg(1)->Arg(2)->ThreadRange(1, 8)->UseRealTime();
+
+// Per-tag query with 10k live allocations over 12 tags, as ContainerMemoryProfiler issues it.
+// Arg 0 scans every record under the global lock; Arg 1 sums MemoryManager's running counters.
+static void BM_AllocatedByTagQuery(benchmark::State& state) {
+    constexpr std::uintptr_t kLive = 10000;
+    GlobalLockTracker scanning;
+    MemoryManager counting;
+    IMemoryManager& manager = state.range(0) == 0 ? static_cast<IMemoryManager&>(scanning)
+                                                  : static_cast<IMemoryManager&>(counting);
+    const std::array<MemoryTag, 12> tags{
+        MemoryTag(1), MemoryTag(2), MemoryTag(3), MemoryTag(4), MemoryTag(5), MemoryTag(6),
+        MemoryTag(7), MemoryTag(8), MemoryTag(9), MemoryTag(10), MemoryTag(11), MemoryTag(12)};
+    for (std::uintptr_t i = 0; i < kLive; ++i) {
+        manager.registerAllocation(reinterpret_cast<void*>(0x10000 + i * 64), 64, tags[i % tags.size()]);
+    }
+
+    for (auto _ : state) {
+        size_t total = 0;
+        for (const auto& tag : tags) {
+            total += manager.getAllocatedByTag(tag);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    for (std::uintptr_t i = 0; i < kLive; ++i) {
+        manager.unregisterAllocation(reinterpret_cast<void*>(0x10000 + i * 64));
+    }
+}
+BENCHMARK(BM_AllocatedByTagQuery)->Arg(0)->Arg(1);
+
+template<typename Allocator>
+static void fillAndClearList(benchmark::State& state, IMemoryManager& manager) {
+    std::list<std::uint64_t, Allocator> nodes{Allocator(manager)};
+    for (auto _ : state) {
+        for (std::uint64_t i = 0; i < 256; ++i) {
+            nodes.push_back(i);
+        }
+        benchmark::DoNotOptimize(nodes.back());
+        nodes.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+
+// Node churn of the std::list behind SoulList: 256 push_backs then clear.
+// Arg 0 allocates from the global heap and tracks every node; Arg 1 goes through
+// MemoryAllocator's thread cache. The second argument picks MemoryManager (0), which still sees
+// every node, or StatisticsMemoryManager (1), which takes per-thread batches.
+static void BM_NodeContainerChurn(benchmark::State& state) {
+    IMemoryManager& manager = state.range(1) == 0 ? static_cast<IMemoryManager&>(g_shardedTracker)
+                                                  : static_cast<IMemoryManager&>(g_statisticsTracker);
+    if (state.range(0) == 0) {
+        fillAndClearList<UncachedAllocator<std::uint64_t>>(state, manager);
+    } else {
+        fillAndClearList<MemoryAllocator<std::uint64_t>>(state, manager);
+    }
 }
-BENCHMARK(BM_ArenaAllocatorLinear);
+BENCHMARK(BM_NodeContainerChurn)->ArgsProduct({{0, 1}, {0, 1}});
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "Async/FrameAllocator.h"
+
+namespace soul::async {
+
+template <typename T>
+class AsyncGenerator;
+
+namespace detail {
+
+template <typename T>
+struct GeneratorPromise : PooledFrame {
+    std::optional<T> value;
+    std::exception_ptr exception;
+    // Coroutine awaiting `next`; the generator hands control back to it on every yield.
+    std::coroutine_handle<> consumer;
+
+    struct YieldAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<GeneratorPromise> handle) const noexcept {
+            return handle.promise().consumer;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    AsyncGenerator<T> get_return_object() noexcept;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    YieldAwaiter final_suspend() const noexcept { return {}; }
+
+    YieldAwaiter yield_value(T produced) {
+        value.emplace(std::move(produced));
+        return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily evaluated coroutine that produces a sequence of values with `co_yield` and may
+ *        `co_await` between them.
+ * @details The body starts on the first `next` and runs until it yields, finishes or throws; it
+ *          then transfers straight back to the consumer, so no job is queued per element. The body
+ *          runs wherever it happens to be: on the consumer's thread, or on the worker that resumed
+ *          one of its own `co_await`s (a `Task`, `sleep_for`, a `Channel`), after which the
+ *          consumer continues there too. One consumer at a time; destroy the generator only while
+ *          it is not running.
+ *
+ * @code
+ * while (true) {
+ *     auto next = chunks.next();
+ *     auto chunk = co_await next;
+ *     if (!chunk) break;
+ *     consume(*chunk);
+ * }
+ * @endcode
+ */
+template <typename T>
+class AsyncGenerator {
+public:
+    using promise_type = detail::GeneratorPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class NextAwaiter {
+    public:
+        explicit NextAwaiter(Handle handle) noexcept
+            : m_handle(handle) {}
+
+        bool await_ready() const noexcept {
+            return !m_handle || m_handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) const noexcept {
+            m_handle.promise().consumer = consumer;
+            return m_handle;
+        }
+
+        /**
+         * @return The next value, or `std::nullopt` once the body has finished.
+         * @throws Whatever the body threw.
+         */
+        std::optional<T> await_resume() {
+            if (!m_handle) {
+                return std::nullopt;
+            }
+            auto& promise = m_handle.promise();
+            if (promise.exception) {
+                std::rethrow_exception(std::exchange(promise.exception, nullptr));
+            }
+            std::optional<T> result;
+            if (!m_handle.done() && promise.value) {
+                result.emplace(std::move(*promise.value));
+                promise.value.reset();
+            }
+            return result;
+        }
+
+    private:
+        Handle m_handle;
+    };
+
+    AsyncGenerator() = default;
+
+    explicit AsyncGenerator(Handle handle) noexcept
+        : m_handle(handle) {}
+
+    AsyncGenerator(const AsyncGenerator&) = delete;
+    AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+
+    AsyncGenerator(AsyncGenerator&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, {})) {}
+
+    AsyncGenerator& operator=(AsyncGenerator&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    ~AsyncGenerator() {
+        reset();
+    }
+
+    /**
+     * @brief Awaitable that resumes the body up to its next `co_yield`.
+     */
+    [[nodiscard]] NextAwaiter next() const noexcept {
+        return NextAwaiter{m_handle};
+    }
+
+    [[nodiscard]] bool done() const noexcept {
+        return !m_handle || m_handle.done();
+    }
+
+private:
+    void reset() noexcept {
+        if (m_handle) {
+            m_handle.destroy();
+            m_handle = {};
+        }
+    }
+
+    Handle m_handle;
+};
+
+template <typename T>
+AsyncGenerator<T> detail::GeneratorPromise<T>::get_return_object() noexcept {
+    return AsyncGenerator<T>{std::coroutine_handle<GeneratorPromise>::from_promise(*this)};
+}
+
+} // namespace soul::async
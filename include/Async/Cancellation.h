@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace soul::async {
+
+/**
+ * @brief Stored in (and rethrown from) tasks that were cancelled before they ran to completion.
+ */
+class OperationCancelled : public std::exception {
+public:
+    const char* what() const noexcept override {
+        return "soul::async operation cancelled";
+    }
+};
+
+namespace detail {
+
+struct CancellationState;
+
+/**
+ * @brief Intrusive callback entry invoked once when cancellation is requested.
+ * @details Entries are embedded in whatever waits (a sleep awaiter, a scheduled task's state), so
+ *          registering never allocates. Callbacks run on the cancelling thread while the source's
+ *          lock is held, which is what lets `disarm` guarantee the callback is not running once it
+ *          returns; they must not cancel the same source or disarm themselves.
+ */
+class CancellationRegistration {
+public:
+    using Callback = void (*)(void* context) noexcept;
+
+    CancellationRegistration() = default;
+    ~CancellationRegistration() {
+        disarm();
+    }
+
+    CancellationRegistration(const CancellationRegistration&) = delete;
+    CancellationRegistration& operator=(const CancellationRegistration&) = delete;
+
+    /**
+     * @brief Links the callback into `state`.
+     * @return `false`, without registering, if cancellation has already been requested.
+     */
+    bool arm(const std::shared_ptr<CancellationState>& state, Callback callback, void* context);
+
+    /**
+     * @brief Unlinks the callback, waiting for it to finish if it is running on another thread.
+     */
+    void disarm() noexcept;
+
+private:
+    friend struct CancellationState;
+
+    std::shared_ptr<CancellationState> m_state;
+    CancellationRegistration* m_prev{nullptr};
+    CancellationRegistration* m_next{nullptr};
+    Callback m_callback{nullptr};
+    void* m_context{nullptr};
+    bool m_linked{false};
+};
+
+struct CancellationState {
+    std::atomic_bool requested{false};
+    std::mutex mutex;
+    CancellationRegistration* callbacks{nullptr};
+
+    /**
+     * @brief Flags cancellation and runs every registered callback once.
+     * @return `true` for the call that actually requested cancellation.
+     */
+    bool request();
+};
+
+} // namespace detail
+
+/**
+ * @brief Read-only view of a `CancellationSource`, passed to the work that should observe it.
+ * @details A default-constructed token can never be cancelled and costs nothing to check.
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    [[nodiscard]] bool can_be_cancelled() const noexcept {
+        return static_cast<bool>(m_state);
+    }
+
+    [[nodiscard]] bool is_cancellation_requested() const noexcept {
+        return m_state && m_state->requested.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Throws `OperationCancelled` if cancellation has been requested.
+     */
+    void throw_if_cancellation_requested() const {
+        if (is_cancellation_requested()) {
+            throw OperationCancelled{};
+        }
+    }
+
+    [[nodiscard]] const std::shared_ptr<detail::CancellationState>& state() const noexcept {
+        return m_state;
+    }
+
+private:
+    friend class CancellationSource;
+
+    explicit CancellationToken(std::shared_ptr<detail::CancellationState> state) noexcept
+        : m_state(std::move(state)) {}
+
+    std::shared_ptr<detail::CancellationState> m_state;
+};
+
+/**
+ * @brief Owner side of a cooperative cancellation signal.
+ * @details Tasks scheduled with the source's token are skipped if they have not started when
+ *          `cancel` runs: they complete immediately with `OperationCancelled`, releasing their
+ *          dependents and awaiters. Work that is already running observes the token itself.
+ */
+class CancellationSource {
+public:
+    CancellationSource()
+        : m_state(std::make_shared<detail::CancellationState>()) {}
+
+    [[nodiscard]] CancellationToken token() const noexcept {
+        return CancellationToken{m_state};
+    }
+
+    [[nodiscard]] bool is_cancellation_requested() const noexcept {
+        return m_state->requested.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Requests cancellation; only the first call has any effect.
+     * @return `true` if this call requested cancellation.
+     */
+    bool cancel() {
+        return m_state->request();
+    }
+
+private:
+    std::shared_ptr<detail::CancellationState> m_state;
+};
+
+} // namespace soul::async
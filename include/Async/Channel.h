@@ -0,0 +1,303 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Async/Task.h"
+
+namespace soul::async {
+
+/**
+ * @brief Bounded multi-producer/multi-consumer queue between coroutines.
+ * @details `co_await channel.send(value)` suspends while the buffer is full and
+ *          `co_await channel.receive()` while it is empty, so a fast producer is held back by its
+ *          consumers instead of growing memory. Waiters are woken in FIFO order and resumed on the
+ *          scheduler's workers, on the channel's lane, never inside the call that woke them. With
+ *          a capacity of 0 every send waits for a receiver to take the value.
+ *
+ *          `close` stops new sends (they report `false`); receivers drain what is buffered and
+ *          then get `std::nullopt`. The ring buffer is allocated once; suspending costs no
+ *          allocation. Destroy the channel only when no coroutine is waiting on it.
+ */
+template <typename T>
+class Channel {
+public:
+    class SendAwaiter {
+    public:
+        SendAwaiter(Channel& channel, T value)
+            : m_channel(&channel), m_value(std::move(value)) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            m_handle = awaiting;
+            return m_channel->suspend_sender(*this);
+        }
+
+        /**
+         * @return `false` if the channel was closed before the value was taken.
+         */
+        bool await_resume() const noexcept {
+            return m_delivered;
+        }
+
+    private:
+        friend class Channel;
+
+        Channel* m_channel;
+        std::optional<T> m_value;
+        bool m_delivered{false};
+        std::coroutine_handle<> m_handle{};
+        SendAwaiter* m_next{nullptr};
+    };
+
+    class ReceiveAwaiter {
+    public:
+        explicit ReceiveAwaiter(Channel& channel) noexcept
+            : m_channel(&channel) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            m_handle = awaiting;
+            return m_channel->suspend_receiver(*this);
+        }
+
+        /**
+         * @return The received value, or `std::nullopt` once the channel is closed and drained.
+         */
+        std::optional<T> await_resume() {
+            return std::move(m_value);
+        }
+
+    private:
+        friend class Channel;
+
+        Channel* m_channel;
+        std::optional<T> m_value;
+        std::coroutine_handle<> m_handle{};
+        ReceiveAwaiter* m_next{nullptr};
+    };
+
+    Channel(std::shared_ptr<TaskScheduler> scheduler,
+            std::size_t capacity,
+            TaskPriority priority = TaskPriority::Normal)
+        : m_scheduler(std::move(scheduler)),
+          m_priority(priority),
+          m_ring(capacity) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    [[nodiscard]] SendAwaiter send(T value) {
+        return SendAwaiter{*this, std::move(value)};
+    }
+
+    [[nodiscard]] ReceiveAwaiter receive() noexcept {
+        return ReceiveAwaiter{*this};
+    }
+
+    /**
+     * @brief Sends without waiting. `value` is moved from only on success.
+     */
+    bool try_send(T&& value) {
+        std::coroutine_handle<> wake;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_closed) {
+                return false;
+            }
+            if (auto* receiver = pop(m_receivers, m_receiversTail)) {
+                receiver->m_value.emplace(std::move(value));
+                wake = receiver->m_handle;
+            } else if (m_count < m_ring.size()) {
+                push_buffer(std::move(value));
+            } else {
+                return false;
+            }
+        }
+        resume(wake);
+        return true;
+    }
+
+    /**
+     * @brief Receives without waiting; `std::nullopt` when nothing is available.
+     */
+    std::optional<T> try_receive() {
+        std::optional<T> value;
+        std::coroutine_handle<> wake;
+        {
+            std::lock_guard lock(m_mutex);
+            wake = take(value);
+        }
+        resume(wake);
+        return value;
+    }
+
+    /**
+     * @brief Rejects further sends and releases every waiting coroutine. Idempotent.
+     */
+    void close() {
+        SendAwaiter* senders = nullptr;
+        ReceiveAwaiter* receivers = nullptr;
+        {
+            std::lock_guard lock(m_mutex);
+            m_closed = true;
+            senders = std::exchange(m_senders, nullptr);
+            m_sendersTail = nullptr;
+            receivers = std::exchange(m_receivers, nullptr);
+            m_receiversTail = nullptr;
+        }
+        // Waiting senders only exist while the buffer is full, so nothing is left for the
+        // receivers, which all get `std::nullopt`.
+        while (senders) {
+            auto* next = senders->m_next;
+            resume(senders->m_handle);
+            senders = next;
+        }
+        while (receivers) {
+            auto* next = receivers->m_next;
+            resume(receivers->m_handle);
+            receivers = next;
+        }
+    }
+
+    [[nodiscard]] bool is_closed() const {
+        std::lock_guard lock(m_mutex);
+        return m_closed;
+    }
+
+    /**
+     * @brief Values currently buffered.
+     */
+    [[nodiscard]] std::size_t size() const {
+        std::lock_guard lock(m_mutex);
+        return m_count;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_ring.size();
+    }
+
+private:
+    template <typename Waiter>
+    static void push(Waiter*& head, Waiter*& tail, Waiter& waiter) noexcept {
+        waiter.m_next = nullptr;
+        if (tail) {
+            tail->m_next = &waiter;
+        } else {
+            head = &waiter;
+        }
+        tail = &waiter;
+    }
+
+    template <typename Waiter>
+    static Waiter* pop(Waiter*& head, Waiter*& tail) noexcept {
+        auto* waiter = head;
+        if (waiter) {
+            head = waiter->m_next;
+            if (!head) {
+                tail = nullptr;
+            }
+        }
+        return waiter;
+    }
+
+    void push_buffer(T&& value) {
+        m_ring[(m_head + m_count) % m_ring.size()].emplace(std::move(value));
+        ++m_count;
+    }
+
+    // Takes the oldest value into `value` and, if a sender was waiting for room, returns it with
+    // its value accepted. Called with the lock held.
+    std::coroutine_handle<> take(std::optional<T>& value) {
+        if (m_count > 0) {
+            auto& slot = m_ring[m_head];
+            value.emplace(std::move(*slot));
+            slot.reset();
+            m_head = (m_head + 1) % m_ring.size();
+            --m_count;
+            if (auto* sender = pop(m_senders, m_sendersTail)) {
+                push_buffer(std::move(*sender->m_value));
+                sender->m_delivered = true;
+                return sender->m_handle;
+            }
+        } else if (auto* sender = pop(m_senders, m_sendersTail)) {
+            // Unbuffered channel: take the value straight from the waiting sender.
+            value.emplace(std::move(*sender->m_value));
+            sender->m_delivered = true;
+            return sender->m_handle;
+        }
+        return {};
+    }
+
+    bool suspend_sender(SendAwaiter& sender) {
+        std::coroutine_handle<> wake;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_closed) {
+                return false;
+            }
+            if (auto* receiver = pop(m_receivers, m_receiversTail)) {
+                receiver->m_value.emplace(std::move(*sender.m_value));
+                wake = receiver->m_handle;
+            } else if (m_count < m_ring.size()) {
+                push_buffer(std::move(*sender.m_value));
+            } else {
+                push(m_senders, m_sendersTail, sender);
+                return true;
+            }
+            sender.m_delivered = true;
+        }
+        resume(wake);
+        return false;
+    }
+
+    bool suspend_receiver(ReceiveAwaiter& receiver) {
+        std::coroutine_handle<> wake;
+        {
+            std::lock_guard lock(m_mutex);
+            wake = take(receiver.m_value);
+            if (!receiver.m_value && !m_closed) {
+                push(m_receivers, m_receiversTail, receiver);
+                return true;
+            }
+        }
+        resume(wake);
+        return false;
+    }
+
+    void resume(std::coroutine_handle<> handle) {
+        if (!handle) {
+            return;
+        }
+        try {
+            m_scheduler->resume_coroutine(handle, m_priority);
+        } catch (...) {
+            // Out of job nodes: resume here rather than strand the waiter.
+            handle.resume();
+        }
+    }
+
+    std::shared_ptr<TaskScheduler> m_scheduler;
+    TaskPriority m_priority;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::optional<T>> m_ring;
+    std::size_t m_head{0};
+    std::size_t m_count{0};
+    bool m_closed{false};
+    // FIFO lists of suspended awaiters; senders wait only while the buffer is full, receivers
+    // only while it is empty.
+    SendAwaiter* m_senders{nullptr};
+    SendAwaiter* m_sendersTail{nullptr};
+    ReceiveAwaiter* m_receivers{nullptr};
+    ReceiveAwaiter* m_receiversTail{nullptr};
+};
+
+} // namespace soul::async
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace soul::async::detail {
+
+/**
+ * @brief Allocates storage for coroutine frames and task states from size-class pools.
+ * @details Requests are rounded up to one of a handful of size classes (64 bytes to 2 KiB) and
+ *          served from a thread-local free list. Empty caches refill in batches from a shared
+ *          depot whose slabs are `Memory::Core::PoolAllocator` instances; overfull caches flush a
+ *          batch back. Blocks may be released on any thread. Larger requests use `::operator new`.
+ */
+void* allocate_frame(std::size_t size);
+
+/**
+ * @brief Returns storage obtained from `allocate_frame`; `size` must match the original request.
+ */
+void deallocate_frame(void* ptr, std::size_t size) noexcept;
+
+/**
+ * @brief Standard allocator adapter so `std::allocate_shared` and shared-pointer control blocks
+ *        draw from the frame pools.
+ */
+template <typename T>
+struct FrameAllocator {
+    using value_type = T;
+
+    FrameAllocator() noexcept = default;
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "FrameAllocator does not support over-aligned types");
+        return static_cast<T*>(allocate_frame(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept {
+        deallocate_frame(ptr, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+/**
+ * @brief Mixin giving a promise type pooled `operator new`/`operator delete` for its frame.
+ */
+struct PooledFrame {
+    static void* operator new(std::size_t size) {
+        return allocate_frame(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        deallocate_frame(ptr, size);
+    }
+};
+
+} // namespace soul::async::detail
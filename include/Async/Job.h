@@ -0,0 +1,188 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Async/SchedulerMetrics.h"
+
+namespace soul::async::detail {
+
+/**
+ * @brief Fixed-size block pool backing jobs whose captures do not fit inline.
+ * @details Blocks of `kBlockSize` bytes are carved from slabs owned by the pool and recycled
+ *          through a free list, so oversized jobs still avoid the global heap after warm-up.
+ *          Requests larger than a block fall back to `::operator new`.
+ */
+class JobStoragePool {
+public:
+    static constexpr std::size_t kBlockSize = 256;
+    static constexpr std::size_t kBlocksPerSlab = 64;
+
+    JobStoragePool() = default;
+    ~JobStoragePool() = default;
+
+    JobStoragePool(const JobStoragePool&) = delete;
+    JobStoragePool& operator=(const JobStoragePool&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment);
+    void deallocate(void* ptr, std::size_t size, std::size_t alignment) noexcept;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct alignas(std::max_align_t) Block {
+        std::byte bytes[kBlockSize];
+    };
+
+    std::mutex m_mutex;
+    FreeBlock* m_freeList{nullptr};
+    std::vector<std::unique_ptr<Block[]>> m_slabs;
+};
+
+/**
+ * @brief Move-only, type-erased `void()` callable with inline storage.
+ * @details Sized so that coroutine resume handles and lambdas capturing a `shared_ptr` plus a
+ *          small payload are stored in place. Larger or throwing-move callables are boxed in a
+ *          `JobStoragePool` block instead of going through the global allocator.
+ */
+class Job {
+public:
+    static constexpr std::size_t kInlineSize = 48;
+
+    Job() noexcept = default;
+
+    template <typename Func,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, Job>>>
+    Job(Func&& func, JobStoragePool& pool) {
+        using Stored = std::decay_t<Func>;
+        if constexpr (fits_inline<Stored>()) {
+            ::new (static_cast<void*>(m_storage)) Stored(std::forward<Func>(func));
+            m_ops = &kInlineOps<Stored>;
+        } else {
+            void* memory = pool.allocate(sizeof(Stored), alignof(Stored));
+            Stored* boxed = nullptr;
+            try {
+                boxed = ::new (memory) Stored(std::forward<Func>(func));
+            } catch (...) {
+                pool.deallocate(memory, sizeof(Stored), alignof(Stored));
+                throw;
+            }
+            ::new (static_cast<void*>(m_storage)) Boxed{boxed, &pool};
+            m_ops = &kBoxedOps<Stored>;
+        }
+    }
+
+    Job(Job&& other) noexcept {
+        move_from(other);
+    }
+
+    Job& operator=(Job&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+    ~Job() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return m_ops != nullptr;
+    }
+
+    void operator()() {
+        m_ops->invoke(m_storage);
+    }
+
+    /**
+     * @brief Destroys the stored callable, releasing its captures immediately.
+     */
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    struct Boxed {
+        void* callable;
+        JobStoragePool* pool;
+    };
+
+    template <typename Stored>
+    static constexpr bool fits_inline() noexcept {
+        return sizeof(Stored) <= kInlineSize &&
+               alignof(Stored) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Stored>;
+    }
+
+    template <typename Stored>
+    static constexpr Ops kInlineOps{
+        [](void* storage) { (*std::launder(static_cast<Stored*>(storage)))(); },
+        [](void* destination, void* source) noexcept {
+            auto* from = std::launder(static_cast<Stored*>(source));
+            ::new (destination) Stored(std::move(*from));
+            from->~Stored();
+        },
+        [](void* storage) noexcept { std::launder(static_cast<Stored*>(storage))->~Stored(); },
+    };
+
+    template <typename Stored>
+    static constexpr Ops kBoxedOps{
+        [](void* storage) {
+            auto* boxed = std::launder(static_cast<Boxed*>(storage));
+            (*static_cast<Stored*>(boxed->callable))();
+        },
+        [](void* destination, void* source) noexcept {
+            ::new (destination) Boxed(*std::launder(static_cast<Boxed*>(source)));
+        },
+        [](void* storage) noexcept {
+            auto* boxed = std::launder(static_cast<Boxed*>(storage));
+            static_cast<Stored*>(boxed->callable)->~Stored();
+            boxed->pool->deallocate(boxed->callable, sizeof(Stored), alignof(Stored));
+        },
+    };
+
+    void move_from(Job& other) noexcept {
+        if (other.m_ops) {
+            other.m_ops->relocate(m_storage, other.m_storage);
+            m_ops = std::exchange(other.m_ops, nullptr);
+        }
+    }
+
+    alignas(std::max_align_t) std::byte m_storage[kInlineSize];
+    const Ops* m_ops{nullptr};
+};
+
+/**
+ * @brief Queue entry recycled by the scheduler; work-stealing deques store pointers to these.
+ */
+struct JobNode {
+    Job job;
+    JobNode* next{nullptr};
+#if SOULLIB_SCHEDULER_METRICS
+    std::chrono::steady_clock::time_point enqueuedAt{};
+#endif
+};
+
+} // namespace soul::async::detail
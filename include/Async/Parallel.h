@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Async/Task.h"
+
+namespace soul::async {
+
+/**
+ * @brief Tuning knobs shared by the `soul::async::parallel` algorithms.
+ */
+struct ParallelOptions {
+    /// Smallest chunk handed to a participant; `0` picks one from the range size and pool width.
+    std::size_t grainSize{0};
+    /// Lane the helper jobs are queued on.
+    TaskPriority priority{TaskPriority::Normal};
+};
+
+namespace detail {
+
+/**
+ * @brief Type-erased driver behind every parallel algorithm.
+ * @details The calling thread and up to `worker_count()` helper jobs claim chunks of `[0, count)`
+ *          from a shared cursor. Chunks are guided: each claim takes a share of what is left
+ *          (never less than the grain), so early chunks are large and the tail splits finely to
+ *          even out load. The caller always participates, so nesting a loop inside a worker, or
+ *          running on a saturated pool, makes progress instead of deadlocking. Helpers that start
+ *          after the range is exhausted return immediately. The first exception thrown by a chunk
+ *          cancels the unclaimed remainder and is rethrown to the caller.
+ */
+struct ParallelLoop {
+    using ChunkFunction = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    static void run(TaskScheduler& scheduler,
+                    std::size_t count,
+                    const ParallelOptions& options,
+                    ChunkFunction function,
+                    void* context);
+};
+
+template <typename Body>
+void run_chunks(TaskScheduler& scheduler, std::size_t count, const ParallelOptions& options, Body& body) {
+    ParallelLoop::run(scheduler, count, options,
+                      [](void* context, std::size_t begin, std::size_t end) {
+                          (*static_cast<Body*>(context))(begin, end);
+                      },
+                      std::addressof(body));
+}
+
+// Splits [0, count) into `blocks` contiguous pieces of near-equal size.
+inline std::size_t block_begin(std::size_t count, std::size_t blocks, std::size_t block) noexcept {
+    return count / blocks * block + std::min(block, count % blocks);
+}
+
+template <typename RandomIt, typename Compare, typename BlockSort>
+void parallel_merge_sort(TaskScheduler& scheduler,
+                         RandomIt first,
+                         RandomIt last,
+                         Compare& comp,
+                         const ParallelOptions& options,
+                         BlockSort blockSort) {
+    constexpr std::size_t kMinParallelSort = 8192;
+    const auto count = static_cast<std::size_t>(last - first);
+    const auto blocks = std::min(scheduler.worker_count() + 1, count / (kMinParallelSort / 2));
+    if (blocks < 2) {
+        blockSort(first, last, comp);
+        return;
+    }
+
+    ParallelOptions perBlock = options;
+    perBlock.grainSize = 1;
+
+    auto sortBlocks = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t block = begin; block < end; ++block) {
+            blockSort(first + block_begin(count, blocks, block), first + block_begin(count, blocks, block + 1), comp);
+        }
+    };
+    run_chunks(scheduler, blocks, perBlock, sortBlocks);
+
+    // Merge neighbouring runs pairwise; std::inplace_merge is stable, so stable block sorts
+    // yield a stable result.
+    for (std::size_t width = 1; width < blocks; width *= 2) {
+        const auto pairs = (blocks + 2 * width - 1) / (2 * width);
+        auto mergePairs = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t pair = begin; pair < end; ++pair) {
+                const auto low = pair * 2 * width;
+                const auto middle = std::min(low + width, blocks);
+                const auto high = std::min(low + 2 * width, blocks);
+                if (middle < high) {
+                    std::inplace_merge(first + block_begin(count, blocks, low),
+                                       first + block_begin(count, blocks, middle),
+                                       first + block_begin(count, blocks, high),
+                                       comp);
+                }
+            }
+        };
+        run_chunks(scheduler, pairs, perBlock, mergePairs);
+    }
+}
+
+} // namespace detail
+
+namespace parallel {
+
+/**
+ * @brief Invokes `body` for every index in `[first, last)` on the scheduler's workers.
+ * @details `body` may take a single index or a `(begin, end)` sub-range; the latter lets tight
+ *          loops vectorise. The call returns once every index has been processed.
+ */
+template <typename Body>
+void parallel_for(TaskScheduler& scheduler,
+                  std::size_t first,
+                  std::size_t last,
+                  Body&& body,
+                  const ParallelOptions& options = {}) {
+    if (last <= first) {
+        return;
+    }
+    auto chunk = [&](std::size_t begin, std::size_t end) {
+        if constexpr (std::is_invocable_v<Body&, std::size_t, std::size_t>) {
+            body(first + begin, first + end);
+        } else {
+            for (std::size_t index = first + begin; index < first + end; ++index) {
+                body(index);
+            }
+        }
+    };
+    detail::run_chunks(scheduler, last - first, options, chunk);
+}
+
+/**
+ * @brief Reduces `[first, last)` with `op`, combining per-chunk partial results in parallel.
+ * @details As with `std::reduce`, `op` must be associative and commutative: partials are
+ *          combined in completion order. `init` is folded in exactly once.
+ */
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(TaskScheduler& scheduler,
+                  RandomIt first,
+                  RandomIt last,
+                  T init,
+                  BinaryOp op = {},
+                  const ParallelOptions& options = {}) {
+    std::mutex resultMutex;
+    std::optional<T> total;
+    auto chunk = [&](std::size_t begin, std::size_t end) {
+        T partial = first[begin];
+        for (auto index = begin + 1; index < end; ++index) {
+            partial = op(std::move(partial), first[index]);
+        }
+        std::lock_guard lock(resultMutex);
+        total = total ? op(std::move(*total), std::move(partial)) : std::move(partial);
+    };
+    detail::run_chunks(scheduler, static_cast<std::size_t>(last - first), options, chunk);
+    return total ? op(std::move(init), std::move(*total)) : init;
+}
+
+/**
+ * @brief Writes `op(*it)` for every element of `[first, last)` to the range starting at `out`.
+ * @return Iterator past the last element written.
+ */
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt parallel_transform(TaskScheduler& scheduler,
+                            RandomIt first,
+                            RandomIt last,
+                            OutputIt out,
+                            UnaryOp op,
+                            const ParallelOptions& options = {}) {
+    const auto count = static_cast<std::size_t>(last - first);
+    auto chunk = [&](std::size_t begin, std::size_t end) {
+        for (auto index = begin; index < end; ++index) {
+            out[index] = op(first[index]);
+        }
+    };
+    detail::run_chunks(scheduler, count, options, chunk);
+    return out + count;
+}
+
+/**
+ * @brief Sorts `[first, last)`: blocks are sorted concurrently and then merged pairwise.
+ * @details Ranges below a few thousand elements are sorted inline with `std::sort`.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(TaskScheduler& scheduler,
+                   RandomIt first,
+                   RandomIt last,
+                   Compare comp = {},
+                   const ParallelOptions& options = {}) {
+    detail::parallel_merge_sort(scheduler, first, last, comp, options,
+                                [](RandomIt begin, RandomIt end, Compare& compare) {
+                                    std::sort(begin, end, compare);
+                                });
+}
+
+/**
+ * @brief Stable variant of `parallel_sort`.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_stable_sort(TaskScheduler& scheduler,
+                          RandomIt first,
+                          RandomIt last,
+                          Compare comp = {},
+                          const ParallelOptions& options = {}) {
+    detail::parallel_merge_sort(scheduler, first, last, comp, options,
+                                [](RandomIt begin, RandomIt end, Compare& compare) {
+                                    std::stable_sort(begin, end, compare);
+                                });
+}
+
+} // namespace parallel
+} // namespace soul::async
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compile-time switch for `TaskScheduler` instrumentation.
+ * @details Defined to `1` by the `SOULLIB_ENABLE_SCHEDULER_METRICS` CMake option (as a public
+ *          definition, since it changes the layout of queued jobs). When `0`, no timestamps are
+ *          taken and no counters exist; `TaskScheduler::metrics()` then reports queue depths only.
+ */
+#ifndef SOULLIB_SCHEDULER_METRICS
+#define SOULLIB_SCHEDULER_METRICS 0
+#endif
+
+namespace soul::async {
+
+/**
+ * @brief Immutable copy of a log2-bucketed duration histogram.
+ * @details Bucket 0 holds samples below 256 ns; bucket `i > 0` holds `[2^(i+7), 2^(i+8))` ns and
+ *          the last bucket everything from 2^30 ns (about 1 s) upwards.
+ */
+struct HistogramSnapshot {
+    static constexpr std::size_t kBuckets = 24;
+
+    std::array<std::uint64_t, kBuckets> buckets{};
+    std::uint64_t count{0};
+    std::chrono::nanoseconds total{0};
+
+    static constexpr std::size_t bucket_for(std::chrono::nanoseconds sample) noexcept {
+        const auto ns = static_cast<std::uint64_t>(sample.count() > 0 ? sample.count() : 0);
+        const auto width = static_cast<std::size_t>(std::bit_width(ns));
+        if (width <= 8) {
+            return 0;
+        }
+        return width - 8 < kBuckets ? width - 8 : kBuckets - 1;
+    }
+
+    /**
+     * @brief Exclusive upper bound of `bucket` (the last bucket reports its lower bound).
+     */
+    static constexpr std::chrono::nanoseconds bucket_upper_bound(std::size_t bucket) noexcept {
+        const auto exponent = bucket + 1 < kBuckets ? bucket + 8 : bucket + 7;
+        return std::chrono::nanoseconds(std::int64_t{1} << exponent);
+    }
+
+    [[nodiscard]] std::chrono::nanoseconds mean() const noexcept {
+        return count ? total / static_cast<std::int64_t>(count) : std::chrono::nanoseconds{0};
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the `quantile` (0..1) sample; zero when empty.
+     */
+    [[nodiscard]] std::chrono::nanoseconds percentile(double quantile) const noexcept {
+        if (count == 0) {
+            return std::chrono::nanoseconds{0};
+        }
+        const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            seen += buckets[bucket];
+            if (seen >= rank) {
+                return bucket_upper_bound(bucket);
+            }
+        }
+        return bucket_upper_bound(kBuckets - 1);
+    }
+
+    HistogramSnapshot& operator+=(const HistogramSnapshot& other) noexcept {
+        for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            buckets[bucket] += other.buckets[bucket];
+        }
+        count += other.count;
+        total += other.total;
+        return *this;
+    }
+};
+
+/**
+ * @brief Per-worker view in a `SchedulerMetrics` snapshot. Counters are cumulative since start.
+ */
+struct WorkerMetrics {
+    /// Worker group (NUMA node) the worker belongs to; see `SchedulerOptions::numaAware`.
+    std::uint32_t group{0};
+    /// Jobs sitting on this worker's local deques, all lanes.
+    std::size_t queueDepth{0};
+    std::uint64_t jobsExecuted{0};
+    /// Jobs this worker took from another worker's deque.
+    std::uint64_t steals{0};
+    /// Times the worker parked on the queue condition variable and was woken again.
+    std::uint64_t wakeUps{0};
+    /// Jobs found while polling before parking; each one saved a park and wake-up.
+    std::uint64_t spinHits{0};
+    std::chrono::nanoseconds idleTime{0};
+    std::chrono::nanoseconds busyTime{0};
+    /// Time from `enqueue` until a worker started the job.
+    HistogramSnapshot queueLatency;
+    HistogramSnapshot executionTime;
+};
+
+/**
+ * @brief Point-in-time snapshot returned by `TaskScheduler::metrics()`.
+ * @details Taken without stopping the workers, so counters of different workers are not read at
+ *          the same instant; each individual value is consistent. Subtract two snapshots to get
+ *          rates over an interval.
+ */
+struct SchedulerMetrics {
+    /// `false` when built without `SOULLIB_SCHEDULER_METRICS`; only queue depths are filled then.
+    bool enabled{false};
+    /// Jobs submitted from outside the pool and not yet taken, all lanes.
+    std::size_t injectedDepth{0};
+    /// Jobs waiting in the deadline heaps.
+    std::size_t deadlineDepth{0};
+    /// `run_io` jobs waiting for an I/O worker.
+    std::size_t ioDepth{0};
+    std::vector<WorkerMetrics> workers;
+
+    [[nodiscard]] std::size_t queue_depth() const noexcept {
+        std::size_t depth = injectedDepth + deadlineDepth + ioDepth;
+        for (const auto& worker : workers) {
+            depth += worker.queueDepth;
+        }
+        return depth;
+    }
+
+    [[nodiscard]] std::uint64_t jobs_executed() const noexcept {
+        std::uint64_t jobs = 0;
+        for (const auto& worker : workers) {
+            jobs += worker.jobsExecuted;
+        }
+        return jobs;
+    }
+
+    [[nodiscard]] HistogramSnapshot queue_latency() const noexcept {
+        HistogramSnapshot merged;
+        for (const auto& worker : workers) {
+            merged += worker.queueLatency;
+        }
+        return merged;
+    }
+
+    [[nodiscard]] HistogramSnapshot execution_time() const noexcept {
+        HistogramSnapshot merged;
+        for (const auto& worker : workers) {
+            merged += worker.executionTime;
+        }
+        return merged;
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Single-writer counter: only the owning worker bumps it, any thread may read it.
+ * @details A relaxed load/store pair instead of an atomic read-modify-write keeps the hot path
+ *          free of locked instructions.
+ */
+class MetricCounter {
+public:
+    void add(std::uint64_t amount) noexcept {
+        m_value.store(m_value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t load() const noexcept {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic_uint64_t m_value{0};
+};
+
+class LatencyHistogram {
+public:
+    void record(std::chrono::nanoseconds sample) noexcept {
+        m_buckets[HistogramSnapshot::bucket_for(sample)].add(1);
+        m_count.add(1);
+        m_totalNanoseconds.add(static_cast<std::uint64_t>(sample.count() > 0 ? sample.count() : 0));
+    }
+
+    [[nodiscard]] HistogramSnapshot snapshot() const noexcept {
+        HistogramSnapshot result;
+        for (std::size_t bucket = 0; bucket < HistogramSnapshot::kBuckets; ++bucket) {
+            result.buckets[bucket] = m_buckets[bucket].load();
+        }
+        result.count = m_count.load();
+        result.total = std::chrono::nanoseconds(static_cast<std::int64_t>(m_totalNanoseconds.load()));
+        return result;
+    }
+
+private:
+    std::array<MetricCounter, HistogramSnapshot::kBuckets> m_buckets{};
+    MetricCounter m_count;
+    MetricCounter m_totalNanoseconds;
+};
+
+/**
+ * @brief Counters owned by one worker, on their own cache lines so workers never share them.
+ */
+struct alignas(64) WorkerCounters {
+    MetricCounter jobsExecuted;
+    MetricCounter steals;
+    MetricCounter wakeUps;
+    MetricCounter spinHits;
+    MetricCounter idleNanoseconds;
+    MetricCounter busyNanoseconds;
+    LatencyHistogram queueLatency;
+    LatencyHistogram executionTime;
+};
+
+} // namespace detail
+} // namespace soul::async
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace soul::async {
+
+/**
+ * @brief Logical CPUs a thread may run on, numbered as the operating system numbers them.
+ */
+using CpuSet = std::vector<std::uint32_t>;
+
+/**
+ * @brief One NUMA node as reported by `numa_topology`.
+ */
+struct NumaNode {
+    std::uint32_t id{0};
+    CpuSet cpus;
+};
+
+/**
+ * @brief How long an idle compute worker keeps looking for work before it parks.
+ * @details A worker that runs dry first polls every queue `spinRounds` times with a CPU pause
+ *          hint in between, then `yieldRounds` more times giving up its time slice in between,
+ *          and only then sleeps on the scheduler's condition variable. While any worker is
+ *          polling, submissions skip the wake-up call altogether, so a burst of short jobs is
+ *          picked up without a futex round trip per job. A worker that finds work while more is
+ *          waiting wakes a sleeper to help.
+ *
+ *          Polling costs CPU time on an otherwise idle pool; set both counts to 0 to park at once.
+ *          On a machine with a single hardware thread `spinRounds` is ignored, since spinning
+ *          there only delays the thread that would produce the work.
+ */
+struct ParkingPolicy {
+    std::uint32_t spinRounds{64};
+    std::uint32_t yieldRounds{8};
+    /// Workers allowed to poll at the same time; 0 means half the pool, rounded up.
+    std::size_t maxSpinningWorkers{0};
+};
+
+/**
+ * @brief Worker placement for `TaskScheduler`.
+ * @details Compute workers are split into groups. Without `numaAware` there is one group; with
+ *          it there is one per NUMA node that received workers. Each group has its own injection
+ *          queue, and work submitted from outside the pool goes to the group of the CPU the
+ *          submitting thread runs on. Idle workers look in their own group (its queue and its
+ *          workers' deques) before the others.
+ *
+ *          I/O workers are separate threads that only run `TaskScheduler::run_io` jobs, so
+ *          blocking file or socket calls never hold a compute worker. Work they spawn, including
+ *          the coroutine awaiting the I/O job, goes back to the compute workers.
+ */
+struct SchedulerOptions {
+    /// Compute workers; 0 means one per hardware thread.
+    std::size_t workerCount{0};
+    /// Compute worker `i` is pinned to `cpuSets[i % cpuSets.size()]`. Empty leaves placement to
+    /// the OS, or to `numaAware`.
+    std::vector<CpuSet> cpuSets;
+    /// Spreads compute workers evenly over the NUMA nodes, each pinned to its node's CPUs unless
+    /// `cpuSets` says otherwise, and groups them per node.
+    bool numaAware{false};
+    /// Dedicated I/O workers; with 0, `run_io` jobs run on the compute workers' low lane.
+    std::size_t ioWorkerCount{0};
+    /// I/O worker `i` is pinned to `ioCpuSets[i % ioCpuSets.size()]`.
+    std::vector<CpuSet> ioCpuSets;
+    /// Spin-then-park behaviour of idle compute workers.
+    ParkingPolicy parking;
+};
+
+/**
+ * @brief NUMA nodes of this machine and their CPUs.
+ * @details Read from sysfs on Linux and from the NUMA API on Windows. Elsewhere, or when the
+ *          information is unavailable, one node holding every hardware thread is reported.
+ */
+[[nodiscard]] std::vector<NumaNode> numa_topology();
+
+/**
+ * @brief Restricts the calling thread to `cpus`.
+ * @return `false` if the platform does not support pinning or refused the set.
+ */
+bool pin_current_thread(const CpuSet& cpus) noexcept;
+
+/**
+ * @brief CPU the calling thread is running on right now, where the platform can tell.
+ */
+[[nodiscard]] std::optional<std::uint32_t> current_cpu() noexcept;
+
+} // namespace soul::async
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <coroutine>
+#include <cstdint>
 #include <deque>
 #include <exception>
 #include <functional>
@@ -10,17 +13,44 @@
 #include <mutex>
 #include <optional>
 #include <span>
+#include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "Async/Cancellation.h"
+#include "Async/FrameAllocator.h"
+#include "Async/Job.h"
+#include "Async/SchedulerMetrics.h"
+#include "Async/SchedulerOptions.h"
+#include "Async/TimerWheel.h"
+#include "Async/Tracer.h"
+
+namespace soul::time {
+class FrameGraph;
+} // namespace soul::time
+
 namespace soul::async {
 
 class TaskScheduler;
 
+/**
+ * @brief Scheduler whose compute worker is running the calling thread, or `nullptr` on any other
+ *        thread (including I/O workers).
+ */
+[[nodiscard]] TaskScheduler* current_scheduler() noexcept;
+
+/**
+ * @brief Index of the compute worker running the calling thread, within `current_scheduler()`.
+ */
+[[nodiscard]] std::optional<std::size_t> current_worker() noexcept;
+
 namespace detail {
 
 struct TaskStateBase;
+struct ContinuationNode;
+struct JoinLatch;
 using TaskStateBasePtr = std::shared_ptr<TaskStateBase>;
 
 struct FinalAwaiter;
@@ -33,6 +63,28 @@ struct TaskPromise;
 
 struct TaskPromiseVoid;
 
+template <typename T>
+struct TaskAwaiter;
+
+struct ParallelLoop;
+
+} // namespace detail
+
+/**
+ * @brief Scheduling lane for tasks and jobs. Workers always drain higher lanes first.
+ */
+enum class TaskPriority : std::uint8_t {
+    High,   ///< Frame-critical work and latency-sensitive networking.
+    Normal, ///< Default lane.
+    Low,    ///< Bulk work such as file I/O that must never delay frame jobs.
+};
+
+inline constexpr std::size_t kTaskPriorityCount = 3;
+
+namespace detail {
+
+inline constexpr auto kNoDeadline = std::chrono::steady_clock::time_point::max();
+
 } // namespace detail
 
 /**
@@ -69,10 +121,123 @@ class Task;
  * @details Tasks scheduled here can express explicit dependency chains via `TaskToken`s. The
  *          scheduler ensures continuations resume on the pool threads and exposes blocking APIs for
  *          shutdown or synchronous waiting in tests and tooling.
+ *
+ *          Each worker owns a lock-free work-stealing deque. Jobs spawned from a worker thread are
+ *          pushed onto that worker's deque and popped LIFO for cache locality; jobs submitted from
+ *          outside the pool go through a shared injection queue. Idle workers steal from random
+ *          victims and keep polling for a short while (`ParkingPolicy`) before parking.
+ *          `SchedulerOptions` can pin workers to CPU sets, group them per NUMA node with a
+ *          node-local injection queue each, and add I/O workers for `run_io`.
+ *
+ *          Every queue is split into `TaskPriority` lanes and a worker looks for high-lane work
+ *          everywhere (including other workers' deques) before touching a lower lane. Work given a
+ *          deadline is promoted towards the high lane as the deadline approaches.
+ *
+ *          Timed resumptions (`sleep_for`, `sleep_until`, `schedule_at`) are filed in a
+ *          hierarchical timing wheel with millisecond ticks. A single timer thread, started on
+ *          first use, hands expired coroutines back to the pool, so a sleeping task never
+ *          occupies a worker.
+ *
+ *          `schedule`, `run_async`, `schedule_at` and the sleeps accept a `CancellationToken`.
+ *          Cancelling a task that has not started yet completes it with `OperationCancelled`
+ *          without resuming it, and does so right away even if it is still waiting on
+ *          dependencies, so whatever waits on it is released promptly. A cancelled sleep wakes
+ *          immediately and throws `OperationCancelled` from the `co_await`.
+ *
+ *          `metrics()` reports queue depths at any time. Building with
+ *          `SOULLIB_SCHEDULER_METRICS` adds per-worker counters and latency histograms; without
+ *          it the instrumentation is compiled out entirely. A `Tracer` attached with `set_tracer`
+ *          records a timeline of jobs, tasks and dependency edges while it is recording.
  */
 class TaskScheduler {
 public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Awaitable returned by `sleep_for`/`sleep_until`.
+     * @details Embeds its timer entry (and cancellation callback), so suspending costs no
+     *          allocation. Resumption happens on a worker, on the requested lane, no earlier than
+     *          the requested time point unless the token is cancelled first.
+     */
+    class SleepAwaiter {
+    public:
+        SleepAwaiter(TaskScheduler& scheduler,
+                     Clock::time_point wakeTime,
+                     TaskPriority priority,
+                     CancellationToken cancellation = {}) noexcept
+            : m_scheduler(&scheduler), m_wakeTime(wakeTime), m_cancellation(std::move(cancellation)) {
+            m_node.priority = priority;
+        }
+
+        bool await_ready() const noexcept {
+            return m_cancellation.is_cancellation_requested() || m_wakeTime <= Clock::now();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            m_node.handle = awaiting;
+            // Armed before the timer so that nothing touches this awaiter once the timer is filed.
+            if (m_cancellation.can_be_cancelled() &&
+                !m_registration.arm(m_cancellation.state(), &SleepAwaiter::on_cancelled, this)) {
+                return false;
+            }
+            return m_scheduler->add_timer(m_node, m_wakeTime);
+        }
+
+        void await_resume() {
+            m_registration.disarm();
+            m_cancellation.throw_if_cancellation_requested();
+        }
+
+    private:
+        static void on_cancelled(void* context) noexcept {
+            auto& self = *static_cast<SleepAwaiter*>(context);
+            self.m_scheduler->cancel_timer(self.m_node);
+        }
+
+        TaskScheduler* m_scheduler;
+        Clock::time_point m_wakeTime;
+        CancellationToken m_cancellation;
+        detail::CancellationRegistration m_registration;
+        detail::TimerNode m_node{};
+    };
+
+    /**
+     * @brief Awaitable returned by `schedule_on` and `yield`.
+     * @details `schedule_on` completes inline when the coroutine already runs on one of this
+     *          scheduler's compute workers; otherwise, like `yield`, it suspends and is resumed
+     *          by a worker on the requested lane.
+     */
+    class ScheduleAwaiter {
+    public:
+        ScheduleAwaiter(TaskScheduler& scheduler, TaskPriority priority, bool yielding) noexcept
+            : m_scheduler(&scheduler), m_priority(priority), m_yielding(yielding) {}
+
+        bool await_ready() const noexcept {
+            return !m_yielding && m_scheduler->owns_current_thread();
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting) {
+            if (m_yielding) {
+                m_scheduler->yield_coroutine(awaiting, m_priority);
+            } else {
+                m_scheduler->resume_coroutine(awaiting, m_priority);
+            }
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        TaskScheduler* m_scheduler;
+        TaskPriority m_priority;
+        bool m_yielding;
+    };
+
     explicit TaskScheduler(std::size_t workerCount = 0);
+
+    /**
+     * @brief Creates the pool with the given worker placement; see `SchedulerOptions`.
+     */
+    explicit TaskScheduler(const SchedulerOptions& options);
     ~TaskScheduler();
 
     TaskScheduler(const TaskScheduler&) = delete;
@@ -94,6 +259,8 @@ public:
 
     /**
      * @brief Requests cooperative shutdown of all workers and wakes any waiting threads.
+     * @details Once the workers have exited, jobs still queued are destroyed without running
+     *          and later submissions are dropped.
      */
     void stop();
 
@@ -107,6 +274,35 @@ public:
     template <typename T>
     Task<T> schedule(Task<T>&& task, std::span<const TaskToken> dependencies = {});
 
+    /**
+     * @brief Registers a coroutine on the given priority lane.
+     */
+    template <typename T>
+    Task<T> schedule(Task<T>&& task, TaskPriority priority, std::span<const TaskToken> dependencies = {});
+
+    /**
+     * @brief Registers a coroutine that is promoted towards `TaskPriority::High` as `deadline` nears.
+     */
+    template <typename T>
+    Task<T> schedule(Task<T>&& task,
+                     TaskPriority priority,
+                     Clock::time_point deadline,
+                     std::span<const TaskToken> dependencies = {},
+                     const CancellationToken& cancellation = {},
+                     std::string_view traceName = {});
+
+    /**
+     * @brief Registers a coroutine that is skipped, completing with `OperationCancelled`, if
+     *        `cancellation` is requested before it starts.
+     * @param traceName Label of the task in the attached `Tracer`'s timeline.
+     */
+    template <typename T>
+    Task<T> schedule(Task<T>&& task,
+                     const CancellationToken& cancellation,
+                     TaskPriority priority = TaskPriority::Normal,
+                     std::span<const TaskToken> dependencies = {},
+                     std::string_view traceName = {});
+
     /**
      * @brief Executes a callable on the worker pool and returns an awaitable task.
      * @tparam Func Callable type (lambda, function, functor) executed on a worker thread.
@@ -118,48 +314,454 @@ public:
               typename Result = std::invoke_result_t<std::decay_t<Func>>>
     Task<Result> run_async(Func&& func);
 
+    /**
+     * @brief Executes a callable on the given priority lane.
+     */
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>>>
+    Task<Result> run_async(TaskPriority priority, Func&& func);
+
+    /**
+     * @brief Executes a callable that is promoted towards `TaskPriority::High` as `deadline` nears.
+     */
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>>>
+    Task<Result> run_async(TaskPriority priority, Clock::time_point deadline, Func&& func);
+
+    /**
+     * @brief Executes a callable unless `cancellation` is requested before a worker picks it up,
+     *        in which case the task completes with `OperationCancelled`.
+     */
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>>>
+    Task<Result> run_async(const CancellationToken& cancellation, TaskPriority priority, Func&& func);
+
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>>>
+    Task<Result> run_async(TaskPriority priority,
+                           Clock::time_point deadline,
+                           const CancellationToken& cancellation,
+                           Func&& func);
+
+    /**
+     * @brief Runs a blocking callable on an I/O worker and returns an awaitable task.
+     * @details Whatever awaits the task resumes on a compute worker. Without I/O workers the
+     *          callable runs on the `TaskPriority::Low` lane instead.
+     */
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>>>
+    Task<Result> run_io(Func&& func);
+
+    /**
+     * @brief `run_io` that completes with `OperationCancelled` instead if `cancellation` is
+     *        requested before an I/O worker picks the job up.
+     */
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>>>
+    Task<Result> run_io(const CancellationToken& cancellation, Func&& func);
+
+    /**
+     * @brief Starts every task in `tasks` with one queue publication and at most one wake-up per
+     *        task, instead of a lock and a notification each.
+     * @details The handles stay in `tasks` and can be awaited or waited on as usual; tasks that
+     *          are empty or already started are skipped. From a worker thread the batch goes onto
+     *          that worker's deque for the others to steal; from outside it goes into the injection
+     *          queue under a single lock. Pass a container as `std::span(tasks)`.
+     */
+    template <typename T>
+    void schedule_batch(std::span<Task<T>> tasks, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Runs `func(i)` for every `i` in `[0, count)` on the pool, published as one batch.
+     * @details `func` is moved into shared storage once rather than copied per job. Each call
+     *          gets its own task, in index order, so results and exceptions stay per item; use
+     *          `when_all` to join them.
+     */
+    template <typename Func,
+              typename Result = std::invoke_result_t<std::decay_t<Func>&, std::size_t>>
+    std::vector<Task<Result>> run_async_bulk(std::size_t count,
+                                             Func&& func,
+                                             TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Moves the awaiting coroutine onto this scheduler's compute workers; a no-op when it
+     *        is already running on one of them.
+     */
+    [[nodiscard]] ScheduleAwaiter schedule_on(TaskPriority priority = TaskPriority::Normal) noexcept {
+        return ScheduleAwaiter{*this, priority, false};
+    }
+
+    /**
+     * @brief Suspends the awaiting coroutine behind the work already queued for its worker
+     *        (and behind earlier outside submissions), then resumes it on the pool.
+     */
+    [[nodiscard]] ScheduleAwaiter yield(TaskPriority priority = TaskPriority::Normal) noexcept {
+        return ScheduleAwaiter{*this, priority, true};
+    }
+
+    /**
+     * @brief `true` on this scheduler's compute worker threads.
+     */
+    [[nodiscard]] bool owns_current_thread() const noexcept;
+
     /**
      * @brief Resumes a coroutine on the scheduler, typically used by continuations.
      */
-    void resume_coroutine(std::coroutine_handle<> handle);
+    void resume_coroutine(std::coroutine_handle<> handle, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Number of worker threads in the pool.
+     */
+    [[nodiscard]] std::size_t worker_count() const noexcept {
+        return m_workers.size();
+    }
+
+    [[nodiscard]] std::size_t io_worker_count() const noexcept {
+        return m_ioThreads.size();
+    }
+
+    /**
+     * @brief Number of worker groups, each with its own injection queue: one per NUMA node with
+     *        workers when `SchedulerOptions::numaAware` is set, otherwise one.
+     */
+    [[nodiscard]] std::size_t worker_group_count() const noexcept {
+        return m_injection.size();
+    }
+
+    /**
+     * @brief Spin-then-park policy in effect, after adjustment to the machine.
+     */
+    [[nodiscard]] const ParkingPolicy& parking_policy() const noexcept {
+        return m_parking;
+    }
+
+    /**
+     * @brief Takes a snapshot of queue depths and, when instrumentation is compiled in, of every
+     *        worker's job, steal, wake-up, idle-time and latency counters.
+     * @details Safe to call from any thread at any rate; it never blocks the workers.
+     */
+    [[nodiscard]] SchedulerMetrics metrics() const;
+
+    /**
+     * @brief Attaches the tracer that records this scheduler's timeline (or detaches it).
+     * @details Recording is controlled by `Tracer::start`/`stop`; a stopped or detached tracer
+     *          costs one atomic load per job. Set it while no work is in flight, typically
+     *          right after construction.
+     */
+    void set_tracer(std::shared_ptr<Tracer> tracer);
+
+    [[nodiscard]] const std::shared_ptr<Tracer>& tracer() const noexcept {
+        return m_tracerOwner;
+    }
+
+    /**
+     * @brief Suspends the awaiting coroutine for at least `duration` without blocking a worker.
+     * @param priority Lane the coroutine is resumed on once the timer expires.
+     */
+    template <typename Rep, typename Period>
+    [[nodiscard]] SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> duration,
+                                         TaskPriority priority = TaskPriority::Normal) {
+        return sleep_until(Clock::now() + std::chrono::ceil<Clock::duration>(duration), priority);
+    }
+
+    /**
+     * @brief Suspends the awaiting coroutine until `wakeTime` without blocking a worker.
+     */
+    [[nodiscard]] SleepAwaiter sleep_until(Clock::time_point wakeTime,
+                                           TaskPriority priority = TaskPriority::Normal) noexcept {
+        return SleepAwaiter{*this, wakeTime, priority};
+    }
+
+    /**
+     * @brief Cancellable `sleep_for`: wakes as soon as `cancellation` is requested and throws
+     *        `OperationCancelled` from the `co_await`.
+     */
+    template <typename Rep, typename Period>
+    [[nodiscard]] SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> duration,
+                                         const CancellationToken& cancellation,
+                                         TaskPriority priority = TaskPriority::Normal) {
+        return sleep_until(Clock::now() + std::chrono::ceil<Clock::duration>(duration), cancellation, priority);
+    }
+
+    [[nodiscard]] SleepAwaiter sleep_until(Clock::time_point wakeTime,
+                                           const CancellationToken& cancellation,
+                                           TaskPriority priority = TaskPriority::Normal) noexcept {
+        return SleepAwaiter{*this, wakeTime, priority, cancellation};
+    }
+
+    /**
+     * @brief Registers a coroutine that starts no earlier than `startTime` and after its dependencies.
+     * @details The delay is tracked by the timer wheel as an extra dependency, so the task holds no
+     *          worker while it waits.
+     */
+    template <typename T>
+    Task<T> schedule_at(Clock::time_point startTime,
+                        Task<T>&& task,
+                        TaskPriority priority = TaskPriority::Normal,
+                        std::span<const TaskToken> dependencies = {},
+                        const CancellationToken& cancellation = {},
+                        std::string_view traceName = {});
 
 private:
     friend struct detail::TaskStateBase;
     friend struct detail::TaskPromiseVoid;
+    friend struct detail::ParallelLoop;
+    friend class soul::time::FrameGraph;
+    friend TaskScheduler* current_scheduler() noexcept;
+    friend std::optional<std::size_t> current_worker() noexcept;
 
     class Worker;
 
-    void enqueue(std::function<void()> job);
+    // Jobs submitted from outside the pool for one worker group.
+    struct InjectionQueue {
+        std::mutex mutex;
+        std::array<std::deque<detail::JobNode*>, kTaskPriorityCount> jobs;
+        std::array<std::atomic_size_t, kTaskPriorityCount> counts{};
+    };
+
+    // Job nodes linked through `next`, published together by `push_batch`.
+    struct JobBatch {
+        detail::JobNode* head{nullptr};
+        detail::JobNode* tail{nullptr};
+        std::size_t count{0};
+
+        void append(detail::JobNode* node) noexcept {
+            if (tail) {
+                tail->next = node;
+            } else {
+                head = node;
+            }
+            tail = node;
+            ++count;
+        }
+    };
+
+    struct DeadlineEntry {
+        Clock::time_point deadline;
+        detail::JobNode* node;
+
+        bool operator>(const DeadlineEntry& other) const noexcept {
+            return deadline > other.deadline;
+        }
+    };
+
+    template <typename Func>
+    void enqueue(Func&& job,
+                 TaskPriority priority = TaskPriority::Normal,
+                 Clock::time_point deadline = detail::kNoDeadline);
+    template <typename Func>
+    void enqueue_io(Func&& job);
+    template <typename Func>
+    [[nodiscard]] detail::JobNode* make_job_node(Func&& job);
     void schedule_state(const std::shared_ptr<detail::TaskStateBase>& state);
-    void on_task_finished(const std::shared_ptr<detail::TaskStateBase>& state);
+    void start_scheduled(const std::shared_ptr<detail::TaskStateBase>& state, bool cancellationJob);
+    static void on_task_cancelled(void* state) noexcept;
+
+    // Returns the attached tracer only while it is recording.
+    [[nodiscard]] Tracer* active_tracer() const noexcept {
+        auto* tracer = m_tracer.load(std::memory_order_acquire);
+        return tracer && tracer->is_recording() ? tracer : nullptr;
+    }
+    void trace_completed(detail::TaskStateBase& state) noexcept;
+    void trace_dependency_released(const detail::ContinuationNode& edge) noexcept;
+
+    [[nodiscard]] bool add_timer(detail::TimerNode& node, Clock::time_point wakeTime);
+    void cancel_timer(detail::TimerNode& node) noexcept;
+    [[nodiscard]] TaskToken start_delay(Clock::time_point startTime,
+                                        TaskPriority priority,
+                                        const CancellationToken& cancellation);
+    void run_timers();
+    [[nodiscard]] std::uint64_t tick_at(Clock::time_point time) const noexcept;
+
+    void yield_coroutine(std::coroutine_handle<> handle, TaskPriority priority);
+    // `injected` bypasses the calling worker's deque, which would pop the job straight back.
+    void push_job(detail::JobNode* node, TaskPriority priority, Clock::time_point deadline, bool injected = false);
+    void push_io_job(detail::JobNode* node);
+    void push_batch(const JobBatch& batch, TaskPriority priority);
+    // Destroys every job still queued once the workers, I/O threads and timer thread are gone.
+    void discard_queued_jobs() noexcept;
+    void run_io_worker(std::size_t index, const CpuSet& cpus);
+    void wake_one_worker();
+    // Wakes up to `count` sleepers, fewer when workers are polling or not enough are asleep.
+    void wake_workers(std::size_t count);
+    [[nodiscard]] std::size_t submission_group() const noexcept;
+    [[nodiscard]] detail::JobNode* take_injected_job(std::size_t lane, std::size_t group);
+    [[nodiscard]] detail::JobNode* take_remote_injected_job(std::size_t lane, std::size_t group);
+    [[nodiscard]] detail::JobNode* take_deadline_job(std::size_t lane);
+    [[nodiscard]] bool has_visible_jobs() const noexcept;
+
+    [[nodiscard]] detail::JobNode* acquire_node();
+    void release_node(detail::JobNode* node) noexcept;
+    detail::JobNode* refill_nodes(std::size_t count);
+    void return_nodes(detail::JobNode* head, detail::JobNode* tail) noexcept;
+
+    // Declared before the node slabs so it outlives the boxed jobs that return storage to it.
+    detail::JobStoragePool m_jobStorage;
+    std::mutex m_nodeMutex;
+    detail::JobNode* m_sharedFreeNodes{nullptr};
+    std::vector<std::unique_ptr<detail::JobNode[]>> m_nodeSlabs;
 
     std::vector<std::unique_ptr<Worker>> m_workers;
+    // Guards parking and `m_running`; each injection queue has its own lock.
     std::mutex m_queueMutex;
     std::condition_variable m_queueCv;
-    std::deque<std::function<void()>> m_jobs;
+    // One per worker group; `m_cpuGroups` maps a CPU to the group that takes its submissions.
+    std::vector<std::unique_ptr<InjectionQueue>> m_injection;
+    std::vector<std::uint32_t> m_cpuGroups;
+    // Min-heaps by deadline, one per base lane, guarded by m_deadlineMutex.
+    std::mutex m_deadlineMutex;
+    std::array<std::vector<DeadlineEntry>, kTaskPriorityCount> m_deadlineJobs;
+    std::atomic_size_t m_deadlineCount{0};
+    std::atomic_size_t m_sleepingWorkers{0};
+    // Workers polling before they park; while any is, submissions need not wake a sleeper.
+    std::atomic_size_t m_spinningWorkers{0};
+    ParkingPolicy m_parking;
     std::atomic_bool m_running{true};
+    // Set by `stop`; from then on submissions are dropped instead of queued.
+    std::atomic_bool m_stopped{false};
+
+    std::mutex m_ioMutex;
+    std::condition_variable m_ioCv;
+    std::deque<detail::JobNode*> m_ioJobs;
+    std::atomic_size_t m_ioCount{0};
+    std::vector<std::thread> m_ioThreads;
+    bool m_ioStopped{false};
+
+    // Timer wheel ticks are milliseconds since m_timerEpoch; guarded by m_timerMutex.
+    Clock::time_point m_timerEpoch{Clock::now()};
+    std::mutex m_timerMutex;
+    std::condition_variable m_timerCv;
+    detail::TimerWheel m_timerWheel;
+    std::thread m_timerThread;
+    bool m_timersStopped{false};
+
+    std::shared_ptr<Tracer> m_tracerOwner;
+    std::atomic<Tracer*> m_tracer{nullptr};
 };
 
 namespace detail {
 
+/**
+ * @brief Intrusive completion-list entry.
+ * @details Awaiters embed one in their `TaskAwaiter`; dependency edges registered by
+ *          `TaskScheduler::schedule` live in the dependent task's state. Nodes are never allocated
+ *          by the task being completed.
+ */
+struct ContinuationNode {
+    ContinuationNode* next{nullptr};
+    std::coroutine_handle<> handle{};
+    // Non-null for dependency edges: completion releases one pending dependency of this task.
+    TaskStateBase* dependent{nullptr};
+    // Non-null for `when_all`/`when_any` children: completion reports to the join instead.
+    JoinLatch* latch{nullptr};
+};
+
+/**
+ * @brief Completion target shared by the children of a `when_all`/`when_any` join.
+ * @details `arrive` runs on the completing thread, once per child node, and returns the
+ *          coroutine to resume (the awaiting one, for the arrival that completes the join) or a
+ *          null handle. The returned coroutine takes the usual continuation path, so the last child
+ *          resumes the joiner inline.
+ */
+struct JoinLatch {
+    std::coroutine_handle<> (*arrive)(JoinLatch& latch, ContinuationNode& node) noexcept;
+};
+
+/**
+ * @brief Bookkeeping for tasks scheduled with dependencies, a cancellation token or a tracer.
+ * @details Allocated only for those tasks, so plain tasks keep a small state.
+ */
+struct TaskScheduling {
+    std::unique_ptr<ContinuationNode[]> dependencyEdges;
+    CancellationToken cancellation;
+    CancellationRegistration registration;
+    // Taken by whichever of the regular start and a cancellation reaches the task first.
+    std::atomic_bool claimed{false};
+    std::size_t dependencyCount{0};
+    // Set when a tracer was recording at schedule time. Ids `traceId + 1 + i` name the flow
+    // arrows of dependency edge `i`.
+    const char* traceName{nullptr};
+    std::uint64_t traceId{0};
+    // First run of a traced task. Only the starting thread touches `traceSliceOpen`: it closes
+    // the slice either when the run returns or, if the task completes within it, at completion.
+    std::chrono::steady_clock::time_point traceStart{};
+    std::thread::id traceThread{};
+    bool traceSliceOpen{false};
+};
+
+/**
+ * @brief Completion state shared by a coroutine frame (or `run_async` job) and its handles.
+ * @details A single atomic word encodes the lifecycle: `nullptr` while pending with nobody
+ *          waiting, the head of a lock-free stack of `ContinuationNode`s once something awaits or
+ *          depends on the task, and a sentinel (the state's own address) after completion.
+ *          Blocking waiters park on the same word with `std::atomic::wait`, so completing a task
+ *          never takes a lock.
+ */
 struct TaskStateBase : std::enable_shared_from_this<TaskStateBase> {
     TaskStateBase() = default;
-    virtual ~TaskStateBase() = default;
+    virtual ~TaskStateBase();
 
-    std::mutex continuationMutex;
-    std::vector<std::coroutine_handle<>> continuations;
-    std::condition_variable completionCv;
-    bool completed{false};
-    TaskScheduler* scheduler{nullptr};
+    std::atomic<void*> continuations{nullptr};
+    // Set by whichever party first resumes the coroutine so it is never started twice.
+    std::atomic_bool started{false};
+    TaskPriority priority{TaskPriority::Normal};
     std::atomic_uint32_t pendingDependencies{0};
-    std::vector<std::weak_ptr<TaskStateBase>> dependents;
+    TaskScheduler* scheduler{nullptr};
     std::coroutine_handle<> coroutine{};
     std::exception_ptr exception;
+    // Reference held by a running (or dependency-blocked) task so it outlives every external handle.
+    std::shared_ptr<TaskStateBase> keepAlive;
+    std::unique_ptr<TaskScheduling> scheduling;
+    std::chrono::steady_clock::time_point deadline{kNoDeadline};
+
+    [[nodiscard]] bool is_completed() const noexcept;
+
+    /**
+     * @brief Claims the right to start the coroutine; fails if it is absent or already claimed.
+     */
+    bool try_start() noexcept;
+
+    /**
+     * @brief Pushes a node onto the completion list.
+     * @return `false` if the task had already completed and the node was not linked.
+     */
+    bool add_continuation(ContinuationNode& node) noexcept;
+
+    /**
+     * @brief Awaiter side of `co_await task`, suitable for returning from `await_suspend`.
+     * @return The producer coroutine when this awaiter starts it, the awaiter itself when the task
+     *         already finished, or `std::noop_coroutine()` once the awaiter is parked.
+     */
+    std::coroutine_handle<> suspend_awaiter(ContinuationNode& node) noexcept;
+
+    /**
+     * @brief Starts the coroutine without awaiting it: on its scheduler if it has one, otherwise
+     *        inline until its first suspension. No-op if it has already been started.
+     */
+    void start_detached();
+
+    /**
+     * @brief Starts the coroutine inline if nobody has yet, then blocks until it completes.
+     */
+    void run_and_wait();
+
+    void wait() const noexcept;
+
+    void rethrow_if_failed() const;
+
+    /**
+     * @brief Publishes completion, wakes blocking waiters and releases dependents.
+     * @return The first registered continuation, which the caller must resume in place (via
+     *         symmetric transfer or a direct call); any others are handed to the scheduler.
+     */
+    [[nodiscard]] std::coroutine_handle<> on_completed();
+
+private:
+    [[nodiscard]] void* completed_marker() const noexcept {
+        return const_cast<TaskStateBase*>(this);
+    }
 
-    void add_continuation(std::coroutine_handle<> handle);
-    void resume_continuations();
-    void wait();
-    void on_completed();
+    static void release_dependent(TaskStateBase& dependent);
 };
 
 template <typename T>
@@ -174,54 +776,102 @@ struct TaskState<void> : TaskStateBase {
     void extract();
 };
 
+/**
+ * @brief Shared-pointer deleter that destroys the coroutine frame embedding the task state.
+ */
+struct FrameDestroyer {
+    std::coroutine_handle<> frame;
+
+    void operator()(TaskStateBase*) const noexcept {
+        frame.destroy();
+    }
+};
+
+template <typename T>
+struct TaskAwaiter {
+    TaskState<T>* state;
+    ContinuationNode node{};
+
+    bool await_ready() const noexcept {
+        return state->is_completed();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        node.handle = awaiting;
+        return state->suspend_awaiter(node);
+    }
+
+    T await_resume() {
+        state->rethrow_if_failed();
+        return state->extract();
+    }
+};
+
+struct InitialAwaiter {
+    TaskStateBase* state;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+
+    void await_resume() const noexcept {
+        state->keepAlive = state->shared_from_this();
+    }
+};
+
 struct FinalAwaiter {
     bool await_ready() const noexcept { return false; }
 
     template <typename Promise>
-    void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
-        auto state = handle.promise().state;
-        state->on_completed();
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        auto& state = handle.promise().state;
+        const auto next = state.on_completed();
+        // Dropping the running reference may destroy this frame; nothing below may touch it.
+        auto keepAlive = std::move(state.keepAlive);
+        return next ? next : std::noop_coroutine();
     }
 
     void await_resume() const noexcept {}
 };
 
+/**
+ * @brief Promise for value-returning tasks.
+ * @details The task state lives inside the coroutine frame, and both frame and shared-pointer
+ *          control block are drawn from the pooled frame allocator, so creating a task costs no
+ *          general-purpose heap allocation once the pools are warm.
+ */
 template <typename T>
-struct TaskPromise {
+struct TaskPromise : PooledFrame {
     using State = TaskState<T>;
-    std::shared_ptr<State> state;
+    State state;
 
-    TaskPromise() : state(std::make_shared<State>()) {}
+    Task<T> get_return_object();
 
-    Task<T> get_return_object() noexcept;
-
-    std::suspend_always initial_suspend() const noexcept { return {}; }
+    InitialAwaiter initial_suspend() noexcept { return {&state}; }
     FinalAwaiter final_suspend() const noexcept { return {}; }
 
     template <typename Value>
     void return_value(Value&& value) {
-        state->result = std::forward<Value>(value);
+        state.result = std::forward<Value>(value);
     }
 
     void unhandled_exception() {
-        state->exception = std::current_exception();
+        state.exception = std::current_exception();
     }
 };
 
-struct TaskPromiseVoid {
-    std::shared_ptr<TaskState<void>> state;
-
-    TaskPromiseVoid() : state(std::make_shared<TaskState<void>>()) {}
+struct TaskPromiseVoid : PooledFrame {
+    using State = TaskState<void>;
+    State state;
 
-    Task<void> get_return_object() noexcept;
+    Task<void> get_return_object();
 
-    std::suspend_always initial_suspend() const noexcept { return {}; }
+    InitialAwaiter initial_suspend() noexcept { return {&state}; }
     FinalAwaiter final_suspend() const noexcept { return {}; }
 
     void return_void() noexcept {}
 
     void unhandled_exception() {
-        state->exception = std::current_exception();
+        state.exception = std::current_exception();
     }
 };
 
@@ -258,36 +908,12 @@ public:
     ~Task() = default;
 
     /**
-     * @brief Indicates whether the coroutine has already finished without suspending.
+     * @brief Returns the awaiter for `co_await`; it carries the continuation node, so awaiting
+     *        registers without allocating and transfers straight into an unstarted producer.
+     * @note The awaiter yields the final value or rethrows any stored exception.
      */
-    bool await_ready() const noexcept {
-        return m_state && m_state->completed;
-    }
-
-    /**
-     * @brief Registers a continuation and resumes the producer coroutine if needed.
-     * @param awaiting Awaiter coroutine to resume once the task completes.
-     */
-    void await_suspend(std::coroutine_handle<> awaiting) const {
-        m_state->add_continuation(awaiting);
-        auto* baseState = static_cast<detail::TaskStateBase*>(m_state.get());
-        if (baseState->coroutine && !baseState->coroutine.done()) {
-            if (baseState->scheduler) {
-                baseState->scheduler->resume_coroutine(baseState->coroutine);
-            } else {
-                baseState->coroutine.resume();
-            }
-        }
-    }
-
-    /**
-     * @brief Retrieves the final value, rethrowing any stored exception.
-     */
-    T await_resume() {
-        if (m_state->exception) {
-            std::rethrow_exception(m_state->exception);
-        }
-        return m_state->extract();
+    detail::TaskAwaiter<T> operator co_await() const noexcept {
+        return detail::TaskAwaiter<T>{m_state.get()};
     }
 
     /**
@@ -295,22 +921,8 @@ public:
      * @note Useful for bridging into legacy synchronous code or unit tests.
      */
     T get() {
-        if (m_state && !m_state->completed) {
-            auto* baseState = static_cast<detail::TaskStateBase*>(m_state.get());
-            if (baseState->coroutine && !baseState->coroutine.done()) {
-                if (baseState->scheduler) {
-                    baseState->scheduler->resume_coroutine(baseState->coroutine);
-                } else {
-                    baseState->coroutine.resume();
-                }
-            }
-            if (!baseState->completed) {
-                baseState->wait();
-            }
-        }
-        if (m_state->exception) {
-            std::rethrow_exception(m_state->exception);
-        }
+        m_state->run_and_wait();
+        m_state->rethrow_if_failed();
         return m_state->extract();
     }
 
@@ -359,58 +971,18 @@ public:
     ~Task() = default;
 
     /**
-     * @brief Indicates whether the coroutine has already finished without suspending.
+     * @brief Returns the awaiter for `co_await`; it propagates any stored exception on resume.
      */
-    bool await_ready() const noexcept {
-        return m_state && m_state->completed;
-    }
-
-    /**
-     * @brief Registers a continuation and resumes the producer coroutine if needed.
-     * @param awaiting Awaiter coroutine to resume once the task completes.
-     */
-    void await_suspend(std::coroutine_handle<> awaiting) const {
-        m_state->add_continuation(awaiting);
-        auto* baseState = static_cast<detail::TaskStateBase*>(m_state.get());
-        if (baseState->coroutine && !baseState->coroutine.done()) {
-            if (baseState->scheduler) {
-                baseState->scheduler->resume_coroutine(baseState->coroutine);
-            } else {
-                baseState->coroutine.resume();
-            }
-        }
-    }
-
-    /**
-     * @brief Propagates any stored exception once the coroutine completes.
-     */
-    void await_resume() {
-        if (m_state->exception) {
-            std::rethrow_exception(m_state->exception);
-        }
-        m_state->extract();
+    detail::TaskAwaiter<void> operator co_await() const noexcept {
+        return detail::TaskAwaiter<void>{m_state.get()};
     }
 
     /**
      * @brief Synchronously waits for completion to aid interop with blocking code.
      */
     void get() {
-        if (m_state && !m_state->completed) {
-            auto* baseState = static_cast<detail::TaskStateBase*>(m_state.get());
-            if (baseState->coroutine && !baseState->coroutine.done()) {
-                if (baseState->scheduler) {
-                    baseState->scheduler->resume_coroutine(baseState->coroutine);
-                } else {
-                    baseState->coroutine.resume();
-                }
-            }
-            if (!baseState->completed) {
-                baseState->wait();
-            }
-        }
-        if (m_state->exception) {
-            std::rethrow_exception(m_state->exception);
-        }
+        m_state->run_and_wait();
+        m_state->rethrow_if_failed();
         m_state->extract();
     }
 
@@ -444,69 +1016,153 @@ inline const std::shared_ptr<detail::TaskStateBase>& TaskToken::state() const no
 }
 
 template <typename T>
-Task<T> detail::TaskPromise<T>::get_return_object() noexcept {
-    state->coroutine = std::coroutine_handle<TaskPromise>::from_promise(*this);
-    return Task<T>{state};
+Task<T> detail::TaskPromise<T>::get_return_object() {
+    auto handle = std::coroutine_handle<TaskPromise>::from_promise(*this);
+    state.coroutine = handle;
+    return Task<T>{std::shared_ptr<State>(&state, FrameDestroyer{handle}, FrameAllocator<State>{})};
 }
 
-inline Task<void> detail::TaskPromiseVoid::get_return_object() noexcept {
-    state->coroutine = std::coroutine_handle<TaskPromiseVoid>::from_promise(*this);
-    return Task<void>{state};
+inline Task<void> detail::TaskPromiseVoid::get_return_object() {
+    auto handle = std::coroutine_handle<TaskPromiseVoid>::from_promise(*this);
+    state.coroutine = handle;
+    return Task<void>{std::shared_ptr<State>(&state, FrameDestroyer{handle}, FrameAllocator<State>{})};
 }
 
-inline void detail::TaskStateBase::add_continuation(std::coroutine_handle<> handle) {
-    bool resumeImmediately = false;
-    {
-        std::lock_guard lock(continuationMutex);
-        if (completed) {
-            resumeImmediately = true;
-        } else {
-            continuations.emplace_back(handle);
+inline detail::TaskStateBase::~TaskStateBase() {
+    // A dependency destroyed before completing (e.g. never started) releases its dependents so
+    // their edge nodes are not left linked into freed memory.
+    void* head = continuations.load(std::memory_order_acquire);
+    if (head == completed_marker()) {
+        return;
+    }
+    auto* node = static_cast<ContinuationNode*>(head);
+    while (node) {
+        auto* next = node->next;
+        if (node->dependent) {
+            release_dependent(*node->dependent);
         }
+        node = next;
     }
+}
 
-    if (resumeImmediately) {
-        if (scheduler) {
-            scheduler->resume_coroutine(handle);
-        } else if (handle) {
-            handle.resume();
+inline bool detail::TaskStateBase::is_completed() const noexcept {
+    return continuations.load(std::memory_order_acquire) == completed_marker();
+}
+
+inline bool detail::TaskStateBase::try_start() noexcept {
+    return coroutine && !started.exchange(true, std::memory_order_acq_rel);
+}
+
+inline bool detail::TaskStateBase::add_continuation(ContinuationNode& node) noexcept {
+    void* head = continuations.load(std::memory_order_acquire);
+    do {
+        if (head == completed_marker()) {
+            return false;
         }
+        node.next = static_cast<ContinuationNode*>(head);
+    } while (!continuations.compare_exchange_weak(head, &node,
+                                                  std::memory_order_release,
+                                                  std::memory_order_acquire));
+    return true;
+}
+
+inline std::coroutine_handle<> detail::TaskStateBase::suspend_awaiter(ContinuationNode& node) noexcept {
+    // Claim the start before publishing the node: once it is linked the awaiter may be resumed
+    // on another thread and destroy the Task that owns this state.
+    const auto producer = try_start() ? coroutine : std::coroutine_handle<>{};
+    if (!add_continuation(node)) {
+        return node.handle;
     }
+    return producer ? producer : std::noop_coroutine();
 }
 
-inline void detail::TaskStateBase::resume_continuations() {
-    std::vector<std::coroutine_handle<>> pending;
-    {
-        std::lock_guard lock(continuationMutex);
-        pending.swap(continuations);
+inline void detail::TaskStateBase::start_detached() {
+    if (!try_start()) {
+        return;
     }
+    if (scheduler) {
+        scheduler->schedule_state(shared_from_this());
+    } else {
+        coroutine.resume();
+    }
+}
 
-    for (auto handle : pending) {
-        if (scheduler) {
-            scheduler->resume_coroutine(handle);
-        } else if (handle) {
-            handle.resume();
-        }
+inline void detail::TaskStateBase::run_and_wait() {
+    if (try_start()) {
+        coroutine.resume();
     }
+    wait();
 }
 
-inline void detail::TaskStateBase::wait() {
-    std::unique_lock lock(continuationMutex);
-    completionCv.wait(lock, [this]() { return completed; });
+inline void detail::TaskStateBase::wait() const noexcept {
+    void* current = continuations.load(std::memory_order_acquire);
+    while (current != completed_marker()) {
+        continuations.wait(current, std::memory_order_acquire);
+        current = continuations.load(std::memory_order_acquire);
+    }
 }
 
-inline void detail::TaskStateBase::on_completed() {
-    {
-        std::lock_guard lock(continuationMutex);
-        completed = true;
+inline void detail::TaskStateBase::rethrow_if_failed() const {
+    if (exception) {
+        std::rethrow_exception(exception);
     }
+}
 
-    completionCv.notify_all();
-    resume_continuations();
+inline std::coroutine_handle<> detail::TaskStateBase::on_completed() {
+    if (scheduling && scheduling->traceId) {
+        scheduler->trace_completed(*this);
+    }
+    auto* head = static_cast<ContinuationNode*>(
+        continuations.exchange(completed_marker(), std::memory_order_acq_rel));
+    continuations.notify_all();
+
+    // The stack is LIFO; restore registration order so the first awaiter gets the hand-off.
+    ContinuationNode* ordered = nullptr;
+    while (head) {
+        auto* next = head->next;
+        head->next = ordered;
+        ordered = head;
+        head = next;
+    }
 
-    if (scheduler) {
-        scheduler->on_task_finished(shared_from_this());
+    std::coroutine_handle<> handoff{};
+    while (ordered) {
+        // Read the link first: resuming or releasing a node may free the memory it lives in.
+        auto* node = ordered;
+        ordered = node->next;
+        if (node->dependent) {
+            if (node->dependent->scheduling->traceId) {
+                node->dependent->scheduler->trace_dependency_released(*node);
+            }
+            release_dependent(*node->dependent);
+            continue;
+        }
+        const auto handle = node->latch ? node->latch->arrive(*node->latch, *node) : node->handle;
+        if (!handle) {
+            continue;
+        }
+        if (!handoff) {
+            handoff = handle;
+        } else if (scheduler) {
+            scheduler->resume_coroutine(handle, priority);
+        } else {
+            handle.resume();
+        }
+    }
+    return handoff;
+}
+
+inline void detail::TaskStateBase::release_dependent(TaskStateBase& dependent) {
+    if (dependent.pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (dependent.scheduler->m_stopped.load(std::memory_order_acquire)) {
+        // Reached from a dependency destroyed during shutdown: nothing will run the dependent, so
+        // drop the reference that kept it alive for its start instead of re-enqueueing it.
+        auto keepAlive = std::move(dependent.keepAlive);
+        return;
     }
+    dependent.scheduler->schedule_state(dependent.shared_from_this());
 }
 
 template <typename T>
@@ -522,65 +1178,302 @@ T detail::TaskState<T>::extract() {
 
 inline void detail::TaskState<void>::extract() {}
 
+namespace detail {
+
+/**
+ * @brief Body of a `run_async` job: runs the callable (or records its cancellation) and completes.
+ */
+template <typename Result, typename Function>
+void run_job(TaskState<Result>& state, Function& job, bool cancelled, bool handOff = false) {
+    if (cancelled) {
+        state.exception = std::make_exception_ptr(OperationCancelled{});
+    } else {
+        try {
+            if constexpr (std::is_void_v<Result>) {
+                job();
+            } else {
+                state.result = job();
+            }
+        } catch (...) {
+            state.exception = std::current_exception();
+        }
+    }
+
+    // Resume the awaiting coroutine directly on this worker rather than re-enqueueing it, unless
+    // this is an I/O worker: then the compute workers take it over.
+    if (auto next = state.on_completed()) {
+        if (handOff) {
+            try {
+                state.scheduler->resume_coroutine(next, state.priority);
+                return;
+            } catch (...) {
+                // No job node available: resuming here is slower but still correct.
+            }
+        }
+        next.resume();
+    }
+}
+
+} // namespace detail
+
 template <typename T>
 Task<T> TaskScheduler::schedule(Task<T>&& task, std::span<const TaskToken> dependencies) {
+    return schedule(std::move(task), TaskPriority::Normal, detail::kNoDeadline, dependencies);
+}
+
+template <typename T>
+Task<T> TaskScheduler::schedule(Task<T>&& task, TaskPriority priority, std::span<const TaskToken> dependencies) {
+    return schedule(std::move(task), priority, detail::kNoDeadline, dependencies);
+}
+
+template <typename T>
+Task<T> TaskScheduler::schedule(Task<T>&& task,
+                                const CancellationToken& cancellation,
+                                TaskPriority priority,
+                                std::span<const TaskToken> dependencies,
+                                std::string_view traceName) {
+    return schedule(std::move(task), priority, detail::kNoDeadline, dependencies, cancellation, traceName);
+}
+
+template <typename T>
+Task<T> TaskScheduler::schedule(Task<T>&& task,
+                                TaskPriority priority,
+                                Clock::time_point deadline,
+                                std::span<const TaskToken> dependencies,
+                                const CancellationToken& cancellation,
+                                std::string_view traceName) {
     auto state = task.state();
     if (!state) {
         return Task<T>{};
     }
 
     state->scheduler = this;
+    if (!state->try_start()) {
+        // Already running or awaited elsewhere; the scheduler only adopts it for continuations.
+        return Task<T>{std::move(state)};
+    }
+    state->priority = priority;
+    state->deadline = deadline;
+
+    const bool cancellable = cancellation.can_be_cancelled();
+    auto* tracer = active_tracer();
+    if (dependencies.empty() && !cancellable && !tracer) {
+        schedule_state(state);
+        return Task<T>{std::move(state)};
+    }
+
+    state->scheduling = std::make_unique<detail::TaskScheduling>();
+    state->scheduling->dependencyCount = dependencies.size();
+    if (tracer) {
+        state->scheduling->traceName = tracer->intern(traceName.empty() ? std::string_view{"task"} : traceName);
+        state->scheduling->traceId = tracer->reserve_ids(1 + dependencies.size());
+    }
+    if (cancellable) {
+        // If the token is already cancelled nothing is armed; the start path notices instead.
+        state->scheduling->cancellation = cancellation;
+        state->scheduling->registration.arm(cancellation.state(), &TaskScheduler::on_task_cancelled, state.get());
+    }
+    if (dependencies.empty()) {
+        schedule_state(state);
+        return Task<T>{std::move(state)};
+    }
 
-    uint32_t pending = 0;
-    for (const auto& token : dependencies) {
-        auto dependencyState = token.state();
+    // The extra count guards against dependencies completing while edges are still being linked;
+    // the keep-alive lets the task run even if the caller drops its handle in the meantime.
+    auto& edges = state->scheduling->dependencyEdges;
+    edges = std::make_unique<detail::ContinuationNode[]>(dependencies.size());
+    state->pendingDependencies.store(1, std::memory_order_relaxed);
+    state->keepAlive = state;
+    for (std::size_t i = 0; i < dependencies.size(); ++i) {
+        const auto& dependencyState = dependencies[i].state();
         if (!dependencyState) {
             continue;
         }
-
-        bool registered = false;
-        {
-            std::lock_guard lock(dependencyState->continuationMutex);
-            if (!dependencyState->completed) {
-                dependencyState->dependents.emplace_back(state);
-                registered = true;
-            }
-        }
-
-        if (registered) {
-            ++pending;
-            state->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        auto& edge = edges[i];
+        edge.dependent = state.get();
+        state->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        if (!dependencyState->add_continuation(edge)) {
+            // Already complete: the edge stays unlinked and is left out of the trace.
+            edge.dependent = nullptr;
+            state->pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
         }
     }
 
-    if (pending == 0) {
+    if (state->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
         schedule_state(state);
     }
 
     return Task<T>{std::move(state)};
 }
 
+template <typename T>
+Task<T> TaskScheduler::schedule_at(Clock::time_point startTime,
+                                   Task<T>&& task,
+                                   TaskPriority priority,
+                                   std::span<const TaskToken> dependencies,
+                                   const CancellationToken& cancellation,
+                                   std::string_view traceName) {
+    std::vector<TaskToken> combined(dependencies.begin(), dependencies.end());
+    combined.push_back(start_delay(startTime, priority, cancellation));
+    return schedule(std::move(task), priority, detail::kNoDeadline, combined, cancellation, traceName);
+}
+
+template <typename Func>
+detail::JobNode* TaskScheduler::make_job_node(Func&& job) {
+    auto* node = acquire_node();
+    try {
+        node->job = detail::Job(std::forward<Func>(job), m_jobStorage);
+    } catch (...) {
+        release_node(node);
+        throw;
+    }
+    return node;
+}
+
+template <typename Func>
+void TaskScheduler::enqueue(Func&& job, TaskPriority priority, Clock::time_point deadline) {
+    if (m_stopped.load(std::memory_order_acquire)) {
+        return;
+    }
+    push_job(make_job_node(std::forward<Func>(job)), priority, deadline);
+}
+
+template <typename Func>
+void TaskScheduler::enqueue_io(Func&& job) {
+    if (m_stopped.load(std::memory_order_acquire)) {
+        return;
+    }
+    push_io_job(make_job_node(std::forward<Func>(job)));
+}
+
 template <typename Func, typename Result>
 Task<Result> TaskScheduler::run_async(Func&& func) {
+    return run_async<Func, Result>(TaskPriority::Normal, detail::kNoDeadline, std::forward<Func>(func));
+}
+
+template <typename Func, typename Result>
+Task<Result> TaskScheduler::run_async(TaskPriority priority, Func&& func) {
+    return run_async<Func, Result>(priority, detail::kNoDeadline, std::forward<Func>(func));
+}
+
+template <typename Func, typename Result>
+Task<Result> TaskScheduler::run_async(TaskPriority priority, Clock::time_point deadline, Func&& func) {
+    return run_async<Func, Result>(priority, deadline, CancellationToken{}, std::forward<Func>(func));
+}
+
+template <typename Func, typename Result>
+Task<Result> TaskScheduler::run_async(const CancellationToken& cancellation, TaskPriority priority, Func&& func) {
+    return run_async<Func, Result>(priority, detail::kNoDeadline, cancellation, std::forward<Func>(func));
+}
+
+template <typename Func, typename Result>
+Task<Result> TaskScheduler::run_async(TaskPriority priority,
+                                      Clock::time_point deadline,
+                                      const CancellationToken& cancellation,
+                                      Func&& func) {
     using FunctionType = std::decay_t<Func>;
-    auto state = std::make_shared<detail::TaskState<Result>>();
+    using State = detail::TaskState<Result>;
+    auto state = std::allocate_shared<State>(detail::FrameAllocator<State>{});
     state->scheduler = this;
+    state->priority = priority;
+    state->deadline = deadline;
+
+    if (cancellation.can_be_cancelled()) {
+        enqueue([state, cancellation, job = FunctionType(std::forward<Func>(func))]() mutable {
+            detail::run_job(*state, job, cancellation.is_cancellation_requested());
+        }, priority, deadline);
+    } else {
+        // Kept separate so uncancellable jobs do not pay for carrying a token.
+        enqueue([state, job = FunctionType(std::forward<Func>(func))]() mutable {
+            detail::run_job(*state, job, false);
+        }, priority, deadline);
+    }
 
-    enqueue([state, job = FunctionType(std::forward<Func>(func))]() mutable {
-        try {
-            if constexpr (std::is_void_v<Result>) {
-                job();
-            } else {
-                state->result = job();
-            }
-        } catch (...) {
-            state->exception = std::current_exception();
-        }
+    return Task<Result>{std::move(state)};
+}
 
-        state->on_completed();
-    });
+template <typename Func, typename Result>
+Task<Result> TaskScheduler::run_io(Func&& func) {
+    return run_io<Func, Result>(CancellationToken{}, std::forward<Func>(func));
+}
+
+template <typename Func, typename Result>
+Task<Result> TaskScheduler::run_io(const CancellationToken& cancellation, Func&& func) {
+    if (m_ioThreads.empty()) {
+        return run_async<Func, Result>(cancellation, TaskPriority::Low, std::forward<Func>(func));
+    }
 
+    using FunctionType = std::decay_t<Func>;
+    using State = detail::TaskState<Result>;
+    auto state = std::allocate_shared<State>(detail::FrameAllocator<State>{});
+    state->scheduler = this;
+    state->priority = TaskPriority::Normal;
+    enqueue_io([state, cancellation, job = FunctionType(std::forward<Func>(func))]() mutable {
+        detail::run_job(*state, job, cancellation.is_cancellation_requested(), true);
+    });
     return Task<Result>{std::move(state)};
 }
 
+template <typename T>
+void TaskScheduler::schedule_batch(std::span<Task<T>> tasks, TaskPriority priority) {
+    if (active_tracer()) {
+        // Traced tasks need their per-task bookkeeping; take the regular path.
+        for (auto& task : tasks) {
+            task = schedule(std::move(task), priority);
+        }
+        return;
+    }
+
+    JobBatch batch;
+    try {
+        for (auto& task : tasks) {
+            const auto& state = task.state();
+            if (!state) {
+                continue;
+            }
+            state->scheduler = this;
+            if (!state->try_start()) {
+                continue;
+            }
+            state->priority = priority;
+            state->deadline = detail::kNoDeadline;
+            batch.append(make_job_node([this, started = std::shared_ptr<detail::TaskStateBase>(state)]() {
+                start_scheduled(started, false);
+            }));
+        }
+    } catch (...) {
+        push_batch(batch, priority);
+        throw;
+    }
+    push_batch(batch, priority);
+}
+
+template <typename Func, typename Result>
+std::vector<Task<Result>> TaskScheduler::run_async_bulk(std::size_t count, Func&& func, TaskPriority priority) {
+    using FunctionType = std::decay_t<Func>;
+    using State = detail::TaskState<Result>;
+    auto shared = std::make_shared<FunctionType>(std::forward<Func>(func));
+
+    std::vector<Task<Result>> tasks;
+    tasks.reserve(count);
+    JobBatch batch;
+    try {
+        for (std::size_t index = 0; index < count; ++index) {
+            auto state = std::allocate_shared<State>(detail::FrameAllocator<State>{});
+            state->scheduler = this;
+            state->priority = priority;
+            batch.append(make_job_node([state, shared, index]() {
+                auto call = [&]() -> Result { return (*shared)(index); };
+                detail::run_job(*state, call, false);
+            }));
+            tasks.emplace_back(std::move(state));
+        }
+    } catch (...) {
+        push_batch(batch, priority);
+        throw;
+    }
+    push_batch(batch, priority);
+    return tasks;
+}
+
 } // namespace soul::async
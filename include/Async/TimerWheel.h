@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace soul::async {
+
+enum class TaskPriority : std::uint8_t;
+
+namespace detail {
+
+/**
+ * @brief Intrusive timer entry. Sleep awaiters embed one, so arming a timer never allocates.
+ */
+struct TimerNode {
+    TimerNode* next{nullptr};
+    // Address of the pointer that links this node into its list; null while the node is not filed.
+    TimerNode** link{nullptr};
+    std::uint64_t dueTick{0};
+    std::coroutine_handle<> handle{};
+    TaskPriority priority{};
+    // Set by a cancellation that found the node unfiled; the owner then never files it.
+    bool cancelled{false};
+};
+
+/**
+ * @brief Hierarchical timing wheel (Varghese & Lauck) with four levels of 64 slots.
+ * @details Level `L` slots span `64^L` ticks, so the wheel covers `64^4` ticks directly; timers
+ *          further out park in the last top-level slot and are re-filed when it cascades. Insert
+ *          and expiry are O(1); entries cascade down at most three times. Not thread-safe: the
+ *          owning `TaskScheduler` guards it with its timer mutex.
+ */
+class TimerWheel {
+public:
+    static constexpr std::size_t kLevels = 4;
+    static constexpr std::size_t kSlotBits = 6;
+    static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+
+    explicit TimerWheel(std::uint64_t startTick = 0) noexcept;
+
+    /**
+     * @brief Files a node by its `dueTick`; nodes already due expire on the next `advance`.
+     */
+    void insert(TimerNode* node) noexcept;
+
+    /**
+     * @brief Unlinks a node that is still armed, in O(1).
+     * @return `false` if the node already expired (or was never inserted).
+     */
+    bool remove(TimerNode* node) noexcept;
+
+    /**
+     * @brief Moves the wheel forward to `tick` and returns the expired nodes as a linked list.
+     * @details Idle stretches are skipped rather than stepped through tick by tick.
+     */
+    [[nodiscard]] TimerNode* advance(std::uint64_t tick) noexcept;
+
+    /**
+     * @brief Earliest tick at which `advance` may produce or cascade timers, if any are armed.
+     * @details Exact for timers on the lowest level; for higher levels it is the tick at which
+     *          the owning slot cascades, which is never later than the timers it holds.
+     */
+    [[nodiscard]] std::optional<std::uint64_t> next_event_tick() const noexcept;
+
+    [[nodiscard]] std::uint64_t current_tick() const noexcept {
+        return m_currentTick;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+private:
+    static constexpr std::size_t shift(std::size_t level) noexcept {
+        return level * kSlotBits;
+    }
+
+    static constexpr std::size_t slot_index(std::uint64_t tick, std::size_t level) noexcept {
+        return static_cast<std::size_t>((tick >> shift(level)) & (kSlots - 1));
+    }
+
+    void file(TimerNode* node) noexcept;
+    static void push(TimerNode*& head, TimerNode* node) noexcept;
+    void cascade(std::size_t level) noexcept;
+    [[nodiscard]] std::optional<std::uint64_t> next_slot_tick() const noexcept;
+
+    std::uint64_t m_currentTick;
+    std::size_t m_size{0};
+    TimerNode* m_expired{nullptr};
+    std::array<std::array<TimerNode*, kSlots>, kLevels> m_slots{};
+};
+
+} // namespace detail
+} // namespace soul::async
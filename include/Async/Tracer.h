@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace soul::async {
+
+enum class TraceEventType : std::uint8_t {
+    Slice,     ///< Work that ran on one thread from `timestamp` for `duration`.
+    TaskBegin, ///< A scheduled task started (or was skipped by cancellation).
+    TaskEnd,   ///< The task completed; may be on another thread than its begin.
+    FlowStart, ///< A dependency completed and released the dependent task `id` refers to.
+    FlowEnd,   ///< The dependent task started; pairs with the `FlowStart` of the same `id`.
+};
+
+/**
+ * @brief One recorded event. Times are nanoseconds since the tracer was created.
+ * @details `name` must outlive the tracer: string literals or pointers from `Tracer::intern`.
+ */
+struct TraceEvent {
+    const char* name{nullptr};
+    std::int64_t timestamp{0};
+    std::int64_t duration{0};
+    std::uint64_t id{0};
+    TraceEventType type{TraceEventType::Slice};
+};
+
+/**
+ * @brief Events recorded by one thread, oldest first, as returned by `Tracer::collect`.
+ */
+struct ThreadTrace {
+    std::uint32_t threadId{0};
+    std::string name;
+    std::vector<TraceEvent> events;
+    /// Events overwritten because the ring buffer wrapped.
+    std::uint64_t dropped{0};
+};
+
+/**
+ * @brief Timeline recorder for task execution, exported as Chrome trace-event JSON.
+ * @details Each recording thread appends to its own fixed-size ring buffer, so recording takes no
+ *          lock and never allocates after the thread's first event; when a buffer is full the
+ *          oldest events are overwritten. Attach a tracer with `TaskScheduler::set_tracer` to get
+ *          one track per worker with a slice per job, a slice and an async span per scheduled
+ *          task (named after its `FrameScheduler` job, if any), and a flow arrow per dependency
+ *          edge. The output loads in Perfetto (ui.perfetto.dev) and `chrome://tracing`.
+ *
+ *          `collect` and `write_chrome_trace` stop recording first and wait for in-flight writers,
+ *          so they can be called while the scheduler is still running. Task events are recorded
+ *          before the task's completion is published; a job's slice is recorded when the job
+ *          returns, so the last jobs may be missing if recording stops the moment a wait returns.
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kDefaultEventsPerThread = std::size_t{1} << 14;
+
+    explicit Tracer(std::size_t eventsPerThread = kDefaultEventsPerThread);
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void start() noexcept;
+
+    /**
+     * @brief Stops recording and waits until no thread is in the middle of writing an event.
+     */
+    void stop() noexcept;
+
+    [[nodiscard]] bool is_recording() const noexcept {
+        return m_recording.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Discards every recorded event. Stops recording.
+     */
+    void clear();
+
+    /**
+     * @brief Returns a pointer to a copy of `name` that lives as long as the tracer.
+     */
+    const char* intern(std::string_view name);
+
+    /**
+     * @brief Reserves `count` consecutive ids, unique within this tracer, and returns the first.
+     */
+    std::uint64_t reserve_ids(std::size_t count = 1) noexcept {
+        return m_nextId.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Labels the calling thread's track in the exported trace.
+     */
+    void set_thread_name(std::string_view name) noexcept;
+
+    void slice(const char* name, Clock::time_point start, Clock::time_point end, std::uint64_t id = 0) noexcept;
+    void task_begin(const char* name, std::uint64_t id) noexcept;
+    void task_end(const char* name, std::uint64_t id) noexcept;
+    void flow_start(std::uint64_t id) noexcept;
+    void flow_end(std::uint64_t id) noexcept;
+
+    /**
+     * @brief Stops recording and copies out every thread's events.
+     */
+    [[nodiscard]] std::vector<ThreadTrace> collect();
+
+    /**
+     * @brief Stops recording and writes a Chrome trace-event JSON document.
+     */
+    void write_chrome_trace(std::ostream& out);
+
+    /**
+     * @brief Same as `write_chrome_trace`, to a file.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    void write_chrome_trace_file(const std::string& path);
+
+private:
+    struct ThreadBuffer {
+        ThreadBuffer(std::thread::id owner, std::uint32_t id, std::size_t capacity)
+            : owner(owner), threadId(id), events(capacity) {}
+
+        std::thread::id owner;
+        std::uint32_t threadId;
+        std::string name;
+        std::vector<TraceEvent> events;
+        // Total events ever written; the next slot is `written % events.size()`.
+        std::atomic_uint64_t written{0};
+        // Raised around each write so `stop` can wait the writer out.
+        std::atomic_bool writing{false};
+    };
+
+    void record(TraceEvent event) noexcept;
+    [[nodiscard]] ThreadBuffer* buffer_for_current_thread() noexcept;
+    [[nodiscard]] std::int64_t since_epoch(Clock::time_point time) const noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_epoch).count();
+    }
+
+    const std::uint64_t m_serial;
+    const std::size_t m_capacity;
+    const Clock::time_point m_epoch{Clock::now()};
+    std::atomic_bool m_recording{false};
+    std::atomic_uint64_t m_nextId{1};
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::unordered_set<std::string> m_names;
+};
+
+} // namespace soul::async
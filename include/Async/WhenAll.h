@@ -0,0 +1,300 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Async/Task.h"
+
+namespace soul::async {
+
+/**
+ * @brief Result of `co_await when_any(...)`: the index of the first task to finish and its value.
+ */
+template <typename T>
+struct WhenAnyResult {
+    std::size_t index;
+    T value;
+};
+
+template <>
+struct WhenAnyResult<void> {
+    std::size_t index;
+};
+
+namespace detail {
+
+template <typename T>
+using WhenAllValue = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+/**
+ * @brief Links `node` into a child's completion list and starts the child if nobody has.
+ * @details A child that already finished (or a null task) arrives immediately; the joiner's own
+ *          outstanding arrival guarantees that this never completes the join.
+ */
+inline void join_child(TaskStateBase* state, ContinuationNode& node, JoinLatch& latch) {
+    node.latch = &latch;
+    if (state && state->add_continuation(node)) {
+        state->start_detached();
+        return;
+    }
+    [[maybe_unused]] const auto resumed = latch.arrive(latch, node);
+}
+
+template <typename T>
+WhenAllValue<T> take_result(const Task<T>& task) {
+    if (!task.state()) {
+        return WhenAllValue<T>{};
+    }
+    if constexpr (std::is_void_v<T>) {
+        return std::monostate{};
+    } else {
+        return task.state()->extract();
+    }
+}
+
+template <typename T>
+void rethrow_if_failed(const Task<T>& task) {
+    if (task.state()) {
+        task.state()->rethrow_if_failed();
+    }
+}
+
+/**
+ * @brief Countdown shared by the children of a `when_all`; the last arrival resumes the joiner.
+ */
+struct WhenAllLatch : JoinLatch {
+    explicit WhenAllLatch(std::size_t children) noexcept
+        : JoinLatch{&WhenAllLatch::on_arrive},
+          remaining(children + 1) {}
+
+    // One count per child plus one released by the joiner once every child is linked.
+    std::atomic_size_t remaining;
+    std::coroutine_handle<> awaiting{};
+
+    bool release_joiner() noexcept {
+        return remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    static std::coroutine_handle<> on_arrive(JoinLatch& latch, ContinuationNode&) noexcept {
+        auto& self = static_cast<WhenAllLatch&>(latch);
+        return self.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 ? self.awaiting
+                                                                            : std::coroutine_handle<>{};
+    }
+};
+
+template <typename... Ts>
+class WhenAllAwaitable {
+public:
+    explicit WhenAllAwaitable(Task<Ts>&&... tasks)
+        : m_tasks(std::move(tasks)...) {}
+
+    WhenAllAwaitable(const WhenAllAwaitable&) = delete;
+    WhenAllAwaitable& operator=(const WhenAllAwaitable&) = delete;
+
+    bool await_ready() const noexcept {
+        return sizeof...(Ts) == 0;
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        m_latch.awaiting = awaiting;
+        std::apply([this](auto&... task) {
+            std::size_t index = 0;
+            (join_child(task.state().get(), m_nodes[index++], m_latch), ...);
+        }, m_tasks);
+        return m_latch.release_joiner();
+    }
+
+    std::tuple<WhenAllValue<Ts>...> await_resume() {
+        std::apply([](const auto&... task) { (detail::rethrow_if_failed(task), ...); }, m_tasks);
+        return std::apply([](const auto&... task) {
+            return std::tuple<WhenAllValue<Ts>...>{take_result(task)...};
+        }, m_tasks);
+    }
+
+private:
+    std::tuple<Task<Ts>...> m_tasks;
+    ContinuationNode m_nodes[sizeof...(Ts) > 0 ? sizeof...(Ts) : 1]{};
+    WhenAllLatch m_latch{sizeof...(Ts)};
+};
+
+template <typename T>
+class WhenAllRangeAwaitable {
+public:
+    explicit WhenAllRangeAwaitable(std::vector<Task<T>> tasks)
+        : m_tasks(std::move(tasks)),
+          m_nodes(std::make_unique<ContinuationNode[]>(m_tasks.size())),
+          m_latch(m_tasks.size()) {}
+
+    WhenAllRangeAwaitable(const WhenAllRangeAwaitable&) = delete;
+    WhenAllRangeAwaitable& operator=(const WhenAllRangeAwaitable&) = delete;
+
+    bool await_ready() const noexcept {
+        return m_tasks.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        m_latch.awaiting = awaiting;
+        for (std::size_t i = 0; i < m_tasks.size(); ++i) {
+            join_child(m_tasks[i].state().get(), m_nodes[i], m_latch);
+        }
+        return m_latch.release_joiner();
+    }
+
+    auto await_resume() {
+        for (const auto& task : m_tasks) {
+            detail::rethrow_if_failed(task);
+        }
+        if constexpr (std::is_void_v<T>) {
+            return;
+        } else {
+            std::vector<T> results;
+            results.reserve(m_tasks.size());
+            for (const auto& task : m_tasks) {
+                results.push_back(take_result(task));
+            }
+            return results;
+        }
+    }
+
+private:
+    std::vector<Task<T>> m_tasks;
+    std::unique_ptr<ContinuationNode[]> m_nodes;
+    WhenAllLatch m_latch;
+};
+
+/**
+ * @brief Join state of a `when_any`, reference counted because losing children finish (and touch
+ *        their nodes) after the joiner may already have moved on.
+ */
+template <typename T>
+struct WhenAnyState : JoinLatch {
+    static constexpr std::size_t kNoWinner = std::numeric_limits<std::size_t>::max();
+
+    explicit WhenAnyState(std::vector<Task<T>> children)
+        : JoinLatch{&WhenAnyState::on_arrive},
+          tasks(std::move(children)),
+          nodes(std::make_unique<ContinuationNode[]>(tasks.size())),
+          references(tasks.size() + 1) {}
+
+    std::vector<Task<T>> tasks;
+    std::unique_ptr<ContinuationNode[]> nodes;
+    // One reference per child node plus one held by the awaitable.
+    std::atomic_size_t references;
+    std::atomic_size_t winner{kNoWinner};
+    // Opened by the winning arrival and by the joiner once every child is linked.
+    std::atomic_int resumeGate{2};
+    std::coroutine_handle<> awaiting{};
+
+    void release() noexcept {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    static std::coroutine_handle<> on_arrive(JoinLatch& latch, ContinuationNode& node) noexcept {
+        auto& self = static_cast<WhenAnyState&>(latch);
+        const auto index = static_cast<std::size_t>(&node - self.nodes.get());
+        std::coroutine_handle<> next{};
+        auto expected = kNoWinner;
+        if (self.winner.compare_exchange_strong(expected, index, std::memory_order_acq_rel) &&
+            self.resumeGate.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            next = self.awaiting;
+        }
+        self.release();
+        return next;
+    }
+};
+
+template <typename T>
+class WhenAnyAwaitable {
+public:
+    explicit WhenAnyAwaitable(std::vector<Task<T>> tasks)
+        : m_state(new WhenAnyState<T>(std::move(tasks))) {}
+
+    WhenAnyAwaitable(const WhenAnyAwaitable&) = delete;
+    WhenAnyAwaitable& operator=(const WhenAnyAwaitable&) = delete;
+
+    ~WhenAnyAwaitable() {
+        if (m_armed) {
+            m_state->release();
+        } else {
+            // Never awaited: no child holds a reference yet.
+            delete m_state;
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return m_state->tasks.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        m_armed = true;
+        m_state->awaiting = awaiting;
+        for (std::size_t i = 0; i < m_state->tasks.size(); ++i) {
+            join_child(m_state->tasks[i].state().get(), m_state->nodes[i], *m_state);
+        }
+        return m_state->resumeGate.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    WhenAnyResult<T> await_resume() {
+        if (m_state->tasks.empty()) {
+            throw std::invalid_argument("when_any requires at least one task");
+        }
+        const auto index = m_state->winner.load(std::memory_order_acquire);
+        const auto& task = m_state->tasks[index];
+        detail::rethrow_if_failed(task);
+        if constexpr (std::is_void_v<T>) {
+            return WhenAnyResult<void>{index};
+        } else {
+            return WhenAnyResult<T>{index, take_result(task)};
+        }
+    }
+
+private:
+    WhenAnyState<T>* m_state;
+    bool m_armed{false};
+};
+
+} // namespace detail
+
+/**
+ * @brief Awaits every task and yields their results as a tuple (`std::monostate` for `void`).
+ * @details Children are linked to one shared countdown; the last one to finish resumes the
+ *          awaiting coroutine inline on its own thread, so joining costs no scheduler round trip.
+ *          Unstarted coroutines are started the way `co_await` would start them. If any child
+ *          throws, the first failure in argument order is rethrown once all have finished.
+ */
+template <typename... Ts>
+[[nodiscard]] detail::WhenAllAwaitable<Ts...> when_all(Task<Ts>... tasks) {
+    return detail::WhenAllAwaitable<Ts...>{std::move(tasks)...};
+}
+
+/**
+ * @brief Range form of `when_all`; yields a `std::vector<T>` in input order (nothing for `void`).
+ */
+template <typename T>
+[[nodiscard]] detail::WhenAllRangeAwaitable<T> when_all(std::vector<Task<T>> tasks) {
+    return detail::WhenAllRangeAwaitable<T>{std::move(tasks)};
+}
+
+/**
+ * @brief Resumes as soon as the first task finishes, yielding its index and result.
+ * @details The remaining tasks keep running; the join state stays alive until each has reported,
+ *          so they may outlive the awaiting coroutine safely. Throws `std::invalid_argument` for an
+ *          empty range, and rethrows if the first task to finish failed.
+ */
+template <typename T>
+[[nodiscard]] detail::WhenAnyAwaitable<T> when_any(std::vector<Task<T>> tasks) {
+    return detail::WhenAnyAwaitable<T>{std::move(tasks)};
+}
+
+} // namespace soul::async
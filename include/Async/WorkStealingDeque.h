@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace soul::async::detail {
+
+/**
+ * @brief Lock-free single-owner work-stealing deque (Chase-Lev).
+ * @tparam T Trivially copyable element type, typically a pointer to a queued job.
+ * @details The owning worker pushes and pops at the bottom without synchronisation in the common
+ *          case, while any other thread may steal from the top with a single CAS. The ring buffer
+ *          grows on demand; superseded buffers are retained until the deque is destroyed because a
+ *          concurrent thief may still be reading from them.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque stores elements in atomic slots");
+
+    explicit WorkStealingDeque(std::size_t initialCapacity = 256) {
+        std::size_t capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        m_buffers.emplace_back(std::make_unique<Buffer>(capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Pushes an element at the bottom. Must only be called by the owning thread.
+     */
+    void push(T item) {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<std::int64_t>(buffer->capacity) - 1) {
+            buffer = grow(buffer, top, bottom);
+        }
+
+        buffer->store(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pops the most recently pushed element. Must only be called by the owning thread.
+     */
+    std::optional<T> pop() {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        T item = buffer->load(bottom);
+        if (top == bottom) {
+            // Last element: race against thieves for it.
+            const bool won = m_top.compare_exchange_strong(top, top + 1,
+                                                           std::memory_order_seq_cst,
+                                                           std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return item;
+    }
+
+    /**
+     * @brief Steals the oldest element. Safe to call from any thread.
+     * @return The stolen element, or `std::nullopt` if the deque was empty or the race was lost.
+     */
+    std::optional<T> steal() {
+        auto top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return std::nullopt;
+        }
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        T item = buffer->load(top);
+        if (!m_top.compare_exchange_strong(top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return item;
+    }
+
+    /**
+     * @brief Approximate number of queued elements; exact only when observed by the owner.
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(std::size_t size)
+            : capacity(size),
+              mask(size - 1),
+              slots(std::make_unique<std::atomic<T>[]>(size)) {}
+
+        T load(std::int64_t index) const noexcept {
+            return slots[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void store(std::int64_t index, T value) noexcept {
+            slots[static_cast<std::size_t>(index) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity;
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Buffer* grow(Buffer* current, std::int64_t top, std::int64_t bottom) {
+        auto next = std::make_unique<Buffer>(current->capacity * 2);
+        for (auto i = top; i < bottom; ++i) {
+            next->store(i, current->load(i));
+        }
+        Buffer* raw = next.get();
+        m_buffers.emplace_back(std::move(next));
+        m_buffer.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<std::int64_t> m_top{0};
+    alignas(64) std::atomic<std::int64_t> m_bottom{0};
+    alignas(64) std::atomic<Buffer*> m_buffer{nullptr};
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+};
+
+} // namespace soul::async::detail
@@ -37,20 +37,35 @@ public:
     /**
      * @brief Asynchronously reads the entire file into memory.
      * @param path Path to the file on disk.
+     * @param cancellation Forwarded to the backend; a cancelled read reports
+     *        `std::errc::operation_canceled`.
      * @return Awaitable that resolves to a `ReadFileResult` with canonical path, buffer, and error
      *         code. The caller should inspect `error` before consuming `data`.
      */
-    soul::async::Task<io::ReadFileResult> read(std::filesystem::path path);
+    soul::async::Task<io::ReadFileResult> read(std::filesystem::path path,
+                                               soul::async::CancellationToken cancellation = {});
+
+    /**
+     * @brief Reads several files concurrently.
+     * @param paths Files to load; every read is issued before any is awaited.
+     * @param cancellation Shared by every read; reads still queued when it fires are skipped.
+     * @return Awaitable resolving to one `ReadFileResult` per path, in input order, once all reads
+     *         have finished.
+     */
+    soul::async::Task<std::vector<io::ReadFileResult>> read_all(std::vector<std::filesystem::path> paths,
+                                                                soul::async::CancellationToken cancellation = {});
 
     /**
      * @brief Asynchronously writes the provided data to the destination file.
      * @param path Target file path, parent directories must exist.
      * @param data Binary payload to encrypt (optional) and persist to disk.
+     * @param cancellation Forwarded to the backend; a cancelled write leaves the file untouched.
      * @return Awaitable that resolves to a `WriteFileResult` capturing the canonical destination and
      *         any error encountered.
      */
     soul::async::Task<io::WriteFileResult> write(std::filesystem::path path,
-                                                 std::span<const std::byte> data);
+                                                 std::span<const std::byte> data,
+                                                 soul::async::CancellationToken cancellation = {});
 
     /**
      * @brief Asynchronously loads UTF-8 text from disk.
@@ -25,19 +25,25 @@ public:
      * @brief Asynchronously reads an entire file into memory.
      *
      * @param path Path to the file that should be read.
+     * @param cancellation Token checked before the backend touches the file; a cancelled request
+     *        completes with `std::errc::operation_canceled` instead.
      * @return Task that completes with the read result.
      */
-    virtual soul::async::Task<ReadFileResult> read(std::filesystem::path path) = 0;
+    virtual soul::async::Task<ReadFileResult> read(std::filesystem::path path,
+                                                   soul::async::CancellationToken cancellation = {}) = 0;
 
     /**
      * @brief Asynchronously writes a buffer to disk, replacing the contents of the file.
      *
      * @param path Path to the file to write.
      * @param data Buffer to write; the data is copied before returning.
+     * @param cancellation Token checked before the backend touches the file; a cancelled request
+     *        completes with `std::errc::operation_canceled` and leaves the file untouched.
      * @return Task that completes with the write result.
      */
     virtual soul::async::Task<WriteFileResult> write(std::filesystem::path path,
-                                                     std::span<const std::byte> data) = 0;
+                                                     std::span<const std::byte> data,
+                                                     soul::async::CancellationToken cancellation = {}) = 0;
 };
 
 } // namespace soul::filesystem::io
@@ -10,14 +10,19 @@ namespace soul::filesystem::io {
 
 /**
  * @brief Default implementation of @ref IAsyncFileIO that performs blocking file work on a task scheduler.
+ * @details File jobs go through `TaskScheduler::run_io`: on the I/O workers if the scheduler has
+ *          any, otherwise on the `TaskPriority::Low` lane, so bulk loads never delay frame work.
+ *          A request whose token is cancelled while it is still queued never opens the file.
  */
 class ThreadPoolAsyncFileIO final : public IAsyncFileIO {
 public:
     explicit ThreadPoolAsyncFileIO(std::shared_ptr<soul::async::TaskScheduler> scheduler);
 
-    soul::async::Task<ReadFileResult> read(std::filesystem::path path) override;
+    soul::async::Task<ReadFileResult> read(std::filesystem::path path,
+                                           soul::async::CancellationToken cancellation = {}) override;
     soul::async::Task<WriteFileResult> write(std::filesystem::path path,
-                                             std::span<const std::byte> data) override;
+                                             std::span<const std::byte> data,
+                                             soul::async::CancellationToken cancellation = {}) override;
 
 private:
     std::shared_ptr<soul::async::TaskScheduler> m_scheduler;
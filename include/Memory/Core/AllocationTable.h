@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Memory/Core/MemoryTag.h"
+
+namespace Memory::Core {
+    struct AllocationInfo {
+        size_t size;
+        MemoryTag tag;
+    };
+
+    // Open-addressing map from live pointer to its AllocationInfo. Records sit inline in one
+    // slot array (linear probing, backward-shift erase), so tracking an allocation never
+    // allocates a node of its own. Not synchronised; MemoryManager guards each table.
+    class AllocationTable {
+    public:
+        // Returns true, with the old record in `replaced`, if `ptr` was already present.
+        bool insert(void* ptr, const AllocationInfo& info, AllocationInfo& replaced);
+        bool erase(void* ptr, AllocationInfo& removed);
+        const AllocationInfo* find(void* ptr) const noexcept;
+        void clear() noexcept;
+        size_t size() const noexcept { return size_; }
+
+        template<typename Visitor>
+        void forEach(Visitor&& visitor) const {
+            for (const auto& slot : slots_) {
+                if (slot.ptr) {
+                    visitor(slot.ptr, slot.info);
+                }
+            }
+        }
+
+    private:
+        struct Slot {
+            void* ptr {nullptr};
+            AllocationInfo info {};
+        };
+
+        size_t home(const void* ptr) const noexcept;
+        void grow();
+
+        std::vector<Slot> slots_;
+        size_t size_ {0};
+        int bits_ {0};
+    };
+}
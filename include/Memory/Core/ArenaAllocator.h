@@ -3,28 +3,51 @@
 #include "IMemoryManager.h"
 #include "MemoryRegistry.h"
 #include "MemoryTag.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace Memory::Core {
 
+enum class ArenaGrowth {
+    // One block of the requested capacity; allocate throws std::bad_alloc once it is full.
+    Fixed,
+    // Starts with a block of the requested capacity and appends blocks, each at least twice the
+    // size of the last, as needed. reset() and rewind() keep every block for reuse.
+    Chained
+};
+
+// Bump allocator over one or more blocks. used() is the position across the whole chain, counting
+// the unusable tail of any block that was left for a later one, and remaining() is what is left
+// of the blocks already held; capacity() is their total size.
 class ArenaAllocator {
 public:
+    // Position returned by mark(); rewind() to it releases everything allocated since.
+    struct Marker {
+        std::size_t block {0};
+        std::size_t offset {0};
+    };
+
     explicit ArenaAllocator(std::size_t capacity,
-                            MemoryTag tag = SOUL_MEMORY_TAG("ArenaAllocator"))
-        : ArenaAllocator(MemoryRegistry::Get(), capacity, tag) {}
+                            MemoryTag tag = SOUL_MEMORY_TAG("ArenaAllocator"),
+                            ArenaGrowth growth = ArenaGrowth::Fixed)
+        : ArenaAllocator(MemoryRegistry::Get(), capacity, tag, growth) {}
 
     ArenaAllocator(IMemoryManager& manager,
                    std::size_t capacity,
-                   MemoryTag tag = SOUL_MEMORY_TAG("ArenaAllocator"))
-        : manager_(&manager), tag_(tag), capacity_(capacity) {
-        if (capacity_ == 0) {
+                   MemoryTag tag = SOUL_MEMORY_TAG("ArenaAllocator"),
+                   ArenaGrowth growth = ArenaGrowth::Fixed)
+        : manager_(&manager), tag_(tag), growth_(growth) {
+        if (capacity == 0) {
             throw std::invalid_argument("ArenaAllocator capacity must be greater than zero");
         }
-        allocateArena();
+        appendBlock(capacity);
+        enterBlock(0);
     }
 
     ArenaAllocator(const ArenaAllocator&) = delete;
@@ -33,20 +56,19 @@ public:
     ArenaAllocator& operator=(ArenaAllocator&&) = delete;
 
     ~ArenaAllocator() {
-        if (buffer_) {
-            manager_->unregisterAllocation(buffer_);
-            ::operator delete(buffer_, std::align_val_t(kAlignment));
+        for (const auto& block : blocks_) {
+            freeBlock(block);
         }
     }
 
     void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
-        std::size_t current = align(offset_, alignment);
-        if (current + size > capacity_) {
-            throw std::bad_alloc();
+        const auto aligned = alignUp(reinterpret_cast<std::uintptr_t>(cursor_), alignment);
+        if (size > static_cast<std::size_t>(limit_ - cursor_) ||
+            aligned + size > reinterpret_cast<std::uintptr_t>(limit_)) {
+            return allocateSlow(size, alignment);
         }
-        char* address = static_cast<char*>(buffer_) + current;
-        offset_ = current + size;
-        return address;
+        cursor_ = reinterpret_cast<char*>(aligned + size);
+        return reinterpret_cast<char*>(aligned);
     }
 
     template<typename T, typename... Args>
@@ -55,30 +77,132 @@ public:
         return new (mem) T(std::forward<Args>(args)...);
     }
 
-    void reset() noexcept { offset_ = 0; }
+    void reset() noexcept { enterBlock(0); }
+
+    Marker mark() const noexcept { return {current_, offset()}; }
+
+    // The marker must come from this arena and not lie past the current position.
+    void rewind(Marker marker) noexcept {
+        if (marker.block != current_) {
+            enterBlock(marker.block);
+        }
+        cursor_ = blocks_[current_].data + marker.offset;
+    }
+
+    // Frees the blocks after the current one, e.g. once a peak frame is over.
+    void releaseUnused() noexcept {
+        while (blocks_.size() > current_ + 1) {
+            freeBlock(blocks_.back());
+            capacity_ -= blocks_.back().size;
+            blocks_.pop_back();
+        }
+    }
 
+    ArenaGrowth growth() const noexcept { return growth_; }
+    std::size_t blockCount() const noexcept { return blocks_.size(); }
     std::size_t capacity() const noexcept { return capacity_; }
-    std::size_t used() const noexcept { return offset_; }
-    std::size_t remaining() const noexcept { return capacity_ - offset_; }
+    std::size_t used() const noexcept { return blocks_[current_].start + offset(); }
+    std::size_t remaining() const noexcept { return capacity_ - used(); }
 
 private:
+    struct Block {
+        char* data {nullptr};
+        std::size_t size {0};
+        // Sum of the sizes of the blocks before this one.
+        std::size_t start {0};
+    };
+
     static constexpr std::size_t kAlignment = alignof(std::max_align_t);
 
-    static std::size_t align(std::size_t value, std::size_t alignment) {
-        return (value + (alignment - 1)) & ~(alignment - 1);
+    static std::uintptr_t alignUp(std::uintptr_t address, std::size_t alignment) noexcept {
+        return (address + (alignment - 1)) & ~static_cast<std::uintptr_t>(alignment - 1);
+    }
+
+    static bool fits(const Block& block, std::size_t size, std::size_t alignment) noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data);
+        return alignUp(base, alignment) - base + size <= block.size;
     }
 
-    void allocateArena() {
-        buffer_ = ::operator new(capacity_, std::align_val_t(kAlignment));
-        manager_->registerAllocation(buffer_, capacity_, tag_);
-        offset_ = 0;
+    std::size_t offset() const noexcept { return static_cast<std::size_t>(cursor_ - blocks_[current_].data); }
+
+    void* allocateSlow(std::size_t size, std::size_t alignment) {
+        if (growth_ == ArenaGrowth::Fixed) {
+            throw std::bad_alloc();
+        }
+        // Retained blocks are reused in order; any too small for this request are skipped.
+        std::size_t next = current_ + 1;
+        while (next < blocks_.size() && !fits(blocks_[next], size, alignment)) {
+            ++next;
+        }
+        if (next == blocks_.size()) {
+            const std::size_t padding = alignment > kAlignment ? alignment - kAlignment : 0;
+            appendBlock(std::max(blocks_.back().size * 2, size + padding));
+        }
+        enterBlock(next);
+        return allocate(size, alignment);
+    }
+
+    void appendBlock(std::size_t size) {
+        blocks_.reserve(blocks_.size() + 1);
+        Block block{static_cast<char*>(::operator new(size, std::align_val_t(kAlignment))), size, capacity_};
+        try {
+            manager_->registerAllocation(block.data, size, tag_);
+        } catch (...) {
+            ::operator delete(block.data, std::align_val_t(kAlignment));
+            throw;
+        }
+        blocks_.push_back(block);
+        capacity_ += size;
+    }
+
+    void freeBlock(const Block& block) noexcept {
+        manager_->unregisterAllocation(block.data, block.size, tag_);
+        ::operator delete(block.data, std::align_val_t(kAlignment));
+    }
+
+    void enterBlock(std::size_t index) noexcept {
+        current_ = index;
+        cursor_ = blocks_[index].data;
+        limit_ = cursor_ + blocks_[index].size;
     }
 
     IMemoryManager* manager_ {nullptr};
     MemoryTag tag_;
-    void* buffer_ {nullptr};
+    ArenaGrowth growth_ {ArenaGrowth::Fixed};
+    std::vector<Block> blocks_;
     std::size_t capacity_ {0};
-    std::size_t offset_ {0};
+    std::size_t current_ {0};
+    // Bump pointer and end of the current block.
+    char* cursor_ {nullptr};
+    char* limit_ {nullptr};
+};
+
+// Rewinds the arena to where it stood at construction when it goes out of scope, releasing every
+// temporary allocated through it in between.
+class ScopedArena {
+public:
+    explicit ScopedArena(ArenaAllocator& arena) noexcept
+        : arena_(arena), marker_(arena.mark()) {}
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    ~ScopedArena() { arena_.rewind(marker_); }
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        return arena_.allocate(size, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        return arena_.template create<T>(std::forward<Args>(args)...);
+    }
+
+    ArenaAllocator& arena() const noexcept { return arena_; }
+
+private:
+    ArenaAllocator& arena_;
+    ArenaAllocator::Marker marker_;
 };
 
 } // namespace Memory::Core
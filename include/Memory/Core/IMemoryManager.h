@@ -4,11 +4,22 @@
 #include "Memory/Core/MemoryTag.h"
 
 namespace Memory::Core {
+    class TagCounters;
+
     class IMemoryManager {
     public:
         virtual ~IMemoryManager() = default;
         virtual void registerAllocation(void* ptr, size_t size, MemoryTag tag) = 0;
         virtual void unregisterAllocation(void* ptr) = 0;
+        // Sized form used by the library's allocators, which know what they free. Managers that
+        // keep no per-pointer records rely on it; by default it forwards to the form above.
+        virtual void unregisterAllocation(void* ptr, size_t /*size*/, MemoryTag /*tag*/) {
+            unregisterAllocation(ptr);
+        }
+        // Managers that keep no per-pointer records can expose their counters so the caching
+        // allocators apply per-thread batches of net per-tag changes instead of calling the two
+        // methods above for every block. nullptr (the default) keeps the per-call path.
+        virtual TagCounters* batchedCounters() noexcept { return nullptr; }
         virtual void reportLeaks() = 0;
         virtual size_t getTotalAllocated() = 0;
         virtual size_t getAllocationCount() = 0;
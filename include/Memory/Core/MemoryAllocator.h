@@ -2,8 +2,8 @@
 
 #include "IMemoryManager.h"
 #include "MemoryRegistry.h"
+#include "ThreadCache.h"
 #include <cstddef>
-#include <new>
 
 namespace Memory::Core {
     namespace detail {
@@ -27,17 +27,18 @@ namespace Memory::Core {
 
         T* allocate(std::size_t n) {
             std::size_t bytes = n * sizeof(T);
-            T* ptr = static_cast<T*>(::operator new(bytes));
-            manager_->registerAllocation(ptr, bytes, detail::kDefaultAllocatorTag);
+            T* ptr = static_cast<T*>(ThreadCache::allocate(bytes));
+            ThreadCache::recordAllocation(*manager_, ptr, bytes, detail::kDefaultAllocatorTag);
             return ptr;
         }
 
-        void deallocate(T* ptr, std::size_t) noexcept {
+        void deallocate(T* ptr, std::size_t n) noexcept {
             if (!ptr) {
                 return;
             }
-            manager_->unregisterAllocation(ptr);
-            ::operator delete(ptr);
+            const std::size_t bytes = n * sizeof(T);
+            ThreadCache::recordRelease(*manager_, ptr, bytes, detail::kDefaultAllocatorTag);
+            ThreadCache::deallocate(ptr, bytes);
         }
 
         template<typename U>
@@ -1,17 +1,22 @@
 #pragma once
 #include "IMemoryManager.h"
+#include "Memory/Core/AllocationTable.h"
 #include "Memory/Core/MemoryStatistics.h"
-#include <unordered_map>
+#include "Memory/Core/TagCounters.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <mutex>
 
 namespace Memory::Core {
-    struct AllocationInfo {
-        size_t size;
-        MemoryTag tag;
-    };
-
+    // Allocation records are spread over address-hashed shards, each with its own lock and
+    // AllocationTable, so threads tracking different pointers almost never contend. Totals and
+    // per-tag figures come from running TagCounters and never touch the records; only leak
+    // reports and getAllocationSize look at them.
     class MemoryManager : public IMemoryManager {
     public:
+        static constexpr size_t kShardCount = 64;
+
         MemoryManager() = default;
         ~MemoryManager() override = default;
         MemoryManager(const MemoryManager&) = delete;
@@ -20,12 +25,13 @@ namespace Memory::Core {
         MemoryManager& operator=(MemoryManager&&) = delete;
 
         void setDebugMode(bool enabled);
-        bool getDebugMode() const noexcept { return debugMode_; }
+        bool getDebugMode() const noexcept { return debugMode_.load(std::memory_order_relaxed); }
         void clear();
 
         // IMemoryManager overrides
         void registerAllocation(void* ptr, size_t size, MemoryTag tag) override;
         void unregisterAllocation(void* ptr) override;
+        using IMemoryManager::unregisterAllocation;
         void reportLeaks() override;
         size_t getTotalAllocated() override;
         size_t getAllocationCount() override;
@@ -34,8 +40,16 @@ namespace Memory::Core {
     MemoryStatistics snapshot() override;
 
     private:
-        bool debugMode_{false};
-        std::unordered_map<void*, AllocationInfo> allocations_;
-        std::mutex mutex_;
+        struct alignas(64) Shard {
+            std::mutex mutex;
+            AllocationTable allocations;
+        };
+
+        static size_t shardIndex(const void* ptr) noexcept;
+        Shard& shardFor(const void* ptr) noexcept { return shards_[shardIndex(ptr)]; }
+
+        std::atomic<bool> debugMode_{false};
+        std::array<Shard, kShardCount> shards_;
+        TagCounters counters_;
     };
-}
\ No newline at end of file
+}
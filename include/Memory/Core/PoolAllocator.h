@@ -31,7 +31,7 @@ public:
 
     ~PoolAllocator() {
         if (memoryBlock_) {
-            manager_->unregisterAllocation(memoryBlock_);
+            manager_->unregisterAllocation(memoryBlock_, blockStride() * BlockCount, tag_);
             ::operator delete[](memoryBlock_, std::align_val_t(Alignment));
         }
     }
@@ -0,0 +1,40 @@
+#pragma once
+#include "IMemoryManager.h"
+#include "Memory/Core/MemoryStatistics.h"
+#include "Memory/Core/TagCounters.h"
+
+namespace Memory::Core {
+    // Tracks totals and per-tag figures only, with no per-pointer records: registering or
+    // releasing an allocation is two relaxed atomic adds. Releases must use the sized
+    // unregisterAllocation, as every SoulLib allocator does; the unsized form cannot tell what
+    // was freed and is ignored. Leak reports list the tags still holding memory, and
+    // getAllocationSize always returns 0.
+    // The caching allocators batch their updates per thread (see ThreadCache); queries apply the
+    // calling thread's pending batch first, other threads' batches land within a few calls.
+    class StatisticsMemoryManager : public IMemoryManager {
+    public:
+        StatisticsMemoryManager() = default;
+        ~StatisticsMemoryManager() override = default;
+        StatisticsMemoryManager(const StatisticsMemoryManager&) = delete;
+        StatisticsMemoryManager& operator=(const StatisticsMemoryManager&) = delete;
+        StatisticsMemoryManager(StatisticsMemoryManager&&) = delete;
+        StatisticsMemoryManager& operator=(StatisticsMemoryManager&&) = delete;
+
+        void clear() noexcept;
+
+        // IMemoryManager overrides
+        void registerAllocation(void* ptr, size_t size, MemoryTag tag) override;
+        void unregisterAllocation(void* ptr) override;
+        void unregisterAllocation(void* ptr, size_t size, MemoryTag tag) override;
+        TagCounters* batchedCounters() noexcept override { return &counters_; }
+        void reportLeaks() override;
+        size_t getTotalAllocated() override;
+        size_t getAllocationCount() override;
+        size_t getAllocationSize(void* ptr) override;
+        size_t getAllocatedByTag(MemoryTag tag) override;
+        MemoryStatistics snapshot() override;
+
+    private:
+        TagCounters counters_;
+    };
+}
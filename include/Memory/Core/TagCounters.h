@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "Memory/Core/MemoryStatistics.h"
+#include "Memory/Core/MemoryTag.h"
+
+namespace Memory::Core {
+    // Running byte and allocation counts per tag, updated with two relaxed atomic adds. Each
+    // thread writes to its own stripe (threads share stripes only past kStripeCount) and queries
+    // sum the stripes: a per-tag lookup is O(stripes), totals are O(stripes * tags), and neither
+    // blocks allocation.
+    // A stripe's value can go negative when memory is freed on another thread than allocated it;
+    // only the sums are meaningful.
+    class TagCounters {
+    public:
+        static constexpr size_t kStripeCount = 16;
+        static constexpr int kTagSlotBits = 6;
+        static constexpr size_t kTagSlots = size_t{1} << kTagSlotBits;
+
+        TagCounters();
+        ~TagCounters();
+        TagCounters(const TagCounters&) = delete;
+        TagCounters& operator=(const TagCounters&) = delete;
+
+        void add(MemoryTag tag, size_t bytes) noexcept { update(tag, static_cast<std::int64_t>(bytes), 1); }
+        void remove(MemoryTag tag, size_t bytes) noexcept { update(tag, -static_cast<std::int64_t>(bytes), -1); }
+        // Applies a net change of `bytes` and `allocations` at once, e.g. a batch flushed by a cache.
+        void update(MemoryTag tag, std::int64_t bytes, std::int64_t allocations) noexcept;
+
+        // Identifies this instance among all that have lived at its address.
+        std::uint64_t generation() const noexcept { return generation_; }
+        // update() on `counters` if it is still the instance created with `generation`; lets a
+        // thread apply a batch it collected without knowing whether the owner has since gone.
+        static void updateIfLive(TagCounters* counters, std::uint64_t generation,
+                                 MemoryTag tag, std::int64_t bytes, std::int64_t allocations) noexcept;
+
+        size_t totalBytes() const noexcept { return totals().bytes; }
+        size_t allocationCount() const noexcept { return totals().allocations; }
+        size_t bytesForTag(MemoryTag tag) const noexcept;
+        // Totals plus one entry per tag with live allocations.
+        MemoryStatistics statistics() const;
+        // Not synchronised with concurrent updates.
+        void reset() noexcept;
+
+    private:
+        struct TagSlot {
+            // 0 while free, kClaiming while the tag is being written, then kReady | hash.
+            std::atomic<std::uint64_t> key {0};
+            MemoryTag tag {};
+            std::atomic<std::int64_t> bytes {0};
+            std::atomic<std::int64_t> allocations {0};
+        };
+
+        struct alignas(64) Stripe {
+            std::array<TagSlot, kTagSlots> tags;
+        };
+
+        struct OverflowEntry {
+            MemoryTag tag;
+            std::int64_t bytes {0};
+            std::int64_t allocations {0};
+        };
+
+        struct Totals {
+            size_t bytes {0};
+            size_t allocations {0};
+        };
+
+        Totals totals() const noexcept;
+        static size_t currentStripe() noexcept;
+        static size_t probeStart(MemoryTag tag) noexcept {
+            return static_cast<size_t>((tag.hash * 0x9E3779B1u) >> (32 - kTagSlotBits));
+        }
+        TagSlot* slotFor(Stripe& stripe, MemoryTag tag) noexcept;
+
+        std::uint64_t generation_ {0};
+        std::array<Stripe, kStripeCount> stripes_;
+        // Tags that found no free slot in their stripe; only reached with more than kTagSlots tags.
+        mutable std::mutex overflowMutex_;
+        std::atomic<bool> overflowUsed_ {false};
+        std::unordered_map<std::uint32_t, OverflowEntry> overflow_;
+    };
+}
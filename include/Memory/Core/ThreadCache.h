@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include "Memory/Core/IMemoryManager.h"
+#include "Memory/Core/MemoryTag.h"
+
+namespace Memory::Core {
+    // Per-thread small-object cache behind MemoryAllocator and TaggedMemoryAllocator.
+    // Requests up to kMaxSmallSize bytes are rounded up to a size class and popped from the calling
+    // thread's free list for it; an empty list is refilled, and an overlong one drained, a batch at
+    // a time from central lists shared by all threads. The central lists carve new blocks out of
+    // kChunkSize chunks and keep them for the life of the process. Larger requests go straight to
+    // the global heap. A block may be freed on any thread, with the size it was requested with.
+    //
+    // Tracking goes through recordAllocation and recordRelease. Managers with per-pointer records
+    // see every call; managers exposing batchedCounters() receive the thread's net change per tag
+    // every kAccountingBatch calls, when the thread exits, and on flushAccounting().
+    class ThreadCache {
+    public:
+        static constexpr size_t kAlignment = 16;
+        static constexpr size_t kMaxSmallSize = 256;
+        static constexpr size_t kSizeClassCount = kMaxSmallSize / kAlignment;
+        static constexpr size_t kChunkSize = 64 * 1024;
+        static constexpr unsigned kAccountingBatch = 128;
+
+        ThreadCache() = delete;
+
+        static void* allocate(size_t bytes);
+        static void deallocate(void* ptr, size_t bytes) noexcept;
+
+        static void recordAllocation(IMemoryManager& manager, void* ptr, size_t bytes, MemoryTag tag);
+        static void recordRelease(IMemoryManager& manager, void* ptr, size_t bytes, MemoryTag tag) noexcept;
+
+        // Applies the calling thread's pending per-tag changes.
+        static void flushAccounting() noexcept;
+        // Hands the calling thread's cached blocks back to the central lists.
+        static void releaseCachedBlocks() noexcept;
+        // Free blocks held by the calling thread's cache.
+        static size_t cachedBlocks() noexcept;
+    };
+}
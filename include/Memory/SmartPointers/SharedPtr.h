@@ -27,9 +27,9 @@ public:
 
         T* raw = new T(std::forward<Args>(args)...);
         manager->registerAllocation(raw, sizeof(T), tagValue);
-        auto deleter = [manager](T* p) {
+        auto deleter = [manager, tagValue](T* p) {
             if (p) {
-                manager->unregisterAllocation(p);
+                manager->unregisterAllocation(p, sizeof(T), tagValue);
                 delete p;
             }
         };
@@ -15,12 +15,13 @@ class UniquePtr {
 public:
     struct Deleter {
         Memory::Core::IMemoryManager* manager {nullptr};
+        Memory::Core::MemoryTag tag {};
 
         void operator()(T* ptr) const {
             if (!ptr || !manager) {
                 return;
             }
-            manager->unregisterAllocation(ptr);
+            manager->unregisterAllocation(ptr, sizeof(T), tag);
             delete ptr;
         }
     };
@@ -38,7 +39,7 @@ public:
 
         T* raw = new T(std::forward<Args>(args)...);
         manager->registerAllocation(raw, sizeof(T), tagValue);
-        return UniquePtr<T>(std::unique_ptr<T, Deleter>(raw, Deleter{manager}));
+        return UniquePtr<T>(std::unique_ptr<T, Deleter>(raw, Deleter{manager, tagValue}));
     }
 
     static UniquePtr<T> create(const std::string& tag = "") {
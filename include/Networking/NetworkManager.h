@@ -4,7 +4,9 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
+#include "Async/AsyncGenerator.h"
 #include "Async/Task.h"
 #include "Networking/Packet.h"
 #include "Networking/Transport.h"
@@ -30,6 +32,14 @@ public:
                    std::shared_ptr<Transport> tcpTransport,
                    std::shared_ptr<Transport> udpTransport);
 
+    /**
+     * @brief Cancels every pending retransmission so no sleeping retry outlives the manager.
+     */
+    ~NetworkManager();
+
+    NetworkManager(const NetworkManager&) = delete;
+    NetworkManager& operator=(const NetworkManager&) = delete;
+
     /**
      * @brief Sends a packet using the transport that matches its delivery guarantee.
      * @param endpoint Remote endpoint to target.
@@ -38,6 +48,12 @@ public:
      *         reliable UDP, once bookkeeping is initialised).
      */
     soul::async::Task<void> send(const Endpoint& endpoint, Packet packet);
+
+    /**
+     * @brief Sends several packets to one endpoint concurrently.
+     * @return Awaitable that completes once every packet has been handed to its transport.
+     */
+    soul::async::Task<void> send_batch(Endpoint endpoint, std::vector<Packet> packets);
     /**
      * @brief Polls all transports for the next available packet.
      * @return Awaitable that resolves to an optional tuple of origin endpoint and received packet.
@@ -45,6 +61,15 @@ public:
      */
     soul::async::Task<std::optional<std::pair<Endpoint, Packet>>> receive();
 
+    /**
+     * @brief Streams incoming packets until `cancellation` is requested.
+     * @details Wraps `receive` in a loop; when no packet is available it sleeps for `idleDelay`
+     *          on the scheduler's timer wheel (holding no worker) before polling again.
+     */
+    soul::async::AsyncGenerator<std::pair<Endpoint, Packet>> receive_stream(
+        soul::async::CancellationToken cancellation,
+        std::chrono::milliseconds idleDelay = std::chrono::milliseconds(1));
+
     /**
     * @brief Enables or disables UDP-layer retransmission for the given logical channel.
     *
@@ -56,7 +81,8 @@ public:
 
     /**
      * @brief Configures timeout and retry budget for UDP retransmissions.
-     * @param interval Delay before retrying pending packets.
+     * @param interval Delay before retrying pending packets. An acknowledgement cancels the
+     *        packet's retry timer right away rather than letting it fire and find nothing to do.
      * @param maxAttempts Total attempts (initial send + retries) before the packet is dropped.
      */
     void configure_udp_retransmission(std::chrono::milliseconds interval, std::uint8_t maxAttempts);
@@ -67,6 +93,8 @@ private:
         Packet packet;
         std::chrono::steady_clock::time_point lastSent;
         std::uint8_t attempts{0};
+        // Cancelled once the packet is acknowledged; observed by its retransmission task.
+        soul::async::CancellationSource cancellation;
     };
 
     struct ReliableChannelState {
@@ -97,8 +125,14 @@ private:
     void record_ack(const Endpoint& endpoint, const PacketHeader& header);
     bool handle_incoming_sequence(const Endpoint& endpoint, const PacketHeader& header);
     void maybe_send_ack(const Endpoint& endpoint, std::uint16_t channel);
-    void schedule_retransmission(const Endpoint& endpoint, std::uint16_t channel, std::uint32_t sequence);
-    soul::async::Task<void> retransmit_after(Endpoint endpoint, std::uint16_t channel, std::uint32_t sequence);
+    void schedule_retransmission(const Endpoint& endpoint,
+                                 std::uint16_t channel,
+                                 std::uint32_t sequence,
+                                 const soul::async::CancellationToken& cancellation);
+    soul::async::Task<void> retransmit_after(Endpoint endpoint,
+                                             std::uint16_t channel,
+                                             std::uint32_t sequence,
+                                             soul::async::CancellationToken cancellation);
     static bool is_sequence_acked(std::uint32_t sequence, std::uint32_t ack, std::uint32_t ackMask);
 };
 
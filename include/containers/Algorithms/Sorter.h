@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <algorithm>
+#include "Async/Parallel.h"
 #include "containers/Core/IContainer.h"
 
 namespace ContainerSystem::Algorithms {
@@ -28,6 +29,27 @@ public:
     static void stableSort(std::vector<T>& vec, const Core::Comparator<T>& comp) {
         std::stable_sort(vec.begin(), vec.end(), comp);
     }
+
+    // Overloads taking a scheduler sort large vectors on its worker pool; small inputs stay inline.
+    template<typename T>
+    static void sortByComparator(std::vector<T>& vec, const Core::Comparator<T>& comp, soul::async::TaskScheduler& scheduler) {
+        soul::async::parallel::parallel_sort(scheduler, vec.begin(), vec.end(), comp);
+    }
+
+    template<typename T>
+    static void sortAscending(std::vector<T>& vec, soul::async::TaskScheduler& scheduler) {
+        soul::async::parallel::parallel_sort(scheduler, vec.begin(), vec.end());
+    }
+
+    template<typename T>
+    static void sortDescending(std::vector<T>& vec, soul::async::TaskScheduler& scheduler) {
+        soul::async::parallel::parallel_sort(scheduler, vec.begin(), vec.end(), std::greater<T>());
+    }
+
+    template<typename T>
+    static void stableSort(std::vector<T>& vec, const Core::Comparator<T>& comp, soul::async::TaskScheduler& scheduler) {
+        soul::async::parallel::parallel_stable_sort(scheduler, vec.begin(), vec.end(), comp);
+    }
 };
 
 } // namespace ContainerSystem::Algorithms
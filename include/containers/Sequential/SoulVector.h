@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Async/Parallel.h"
 #include "Memory/Core/TaggedMemoryAllocator.h"
 #include "containers/Core/ContainerTags.h"
 #include "containers/Core/IContainer.h"
@@ -136,6 +137,38 @@ public:
         std::sort(begin(), end(), comp);
     }
 
+    // Sorts on the scheduler's worker pool; small vectors fall back to std::sort inline.
+    void sort(typename ContainerSystem::Core::Comparator<T> comp, soul::async::TaskScheduler& scheduler) {
+        soul::async::parallel::parallel_sort(scheduler, begin(), end(), comp);
+    }
+
+    // Parallel scan that keeps matches in element order: each block collects its own matches.
+    std::vector<T> findAll(typename ContainerSystem::Core::Predicate<T> pred, soul::async::TaskScheduler& scheduler) const {
+        constexpr std::size_t kMinParallelScan = 4096;
+        if (size_ < kMinParallelScan) {
+            return findAll(std::move(pred));
+        }
+        const std::size_t blocks = scheduler.worker_count() + 1;
+        std::vector<std::vector<T>> blockMatches(blocks);
+        soul::async::ParallelOptions options;
+        options.grainSize = 1;
+        soul::async::parallel::parallel_for(scheduler, 0, blocks, [&](std::size_t block) {
+            const auto first = soul::async::detail::block_begin(size_, blocks, block);
+            const auto last = soul::async::detail::block_begin(size_, blocks, block + 1);
+            for (std::size_t i = first; i < last; ++i) {
+                if (pred(data_[i])) {
+                    blockMatches[block].push_back(data_[i]);
+                }
+            }
+        }, options);
+
+        std::vector<T> matches;
+        for (auto& block : blockMatches) {
+            matches.insert(matches.end(), std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
+        }
+        return matches;
+    }
+
     void reserve(std::size_t newCapacity) {
         if (newCapacity <= capacity_) {
             return;
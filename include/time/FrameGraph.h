@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Async/Task.h"
+
+namespace soul::time {
+
+/**
+ * @brief Job graph that is validated and sorted once, then replayed every frame.
+ * @details Build the graph with `FrameGraph::Builder`, then `compile` it against a scheduler.
+ *          Compiling rejects unknown ids, duplicate names and cycles, and lays the nodes out in
+ *          topological order with a flat dependent list. A replay then only resets one atomic
+ *          counter per node and hands ready nodes to the scheduler's `TaskPriority` lanes through
+ *          pooled job nodes: no task states, name lookups or allocations per frame. When a node
+ *          releases several dependents, the finishing worker runs one of them itself and queues
+ *          the rest. Nodes the scheduler drops, once it is stopped or out of job nodes, run
+ *          inline on the dropping thread, so a replay always finishes.
+ *
+ *          Use it for the stable part of a frame; one-off work still goes through
+ *          `FrameScheduler`. Replays of one graph must not overlap: `dispatch` again only after
+ *          `wait` has returned.
+ */
+class FrameGraph {
+public:
+    using NodeId = std::uint32_t;
+
+    class Builder {
+    public:
+        /**
+         * @brief Adds a job. `job` is invoked once per replay and must stay valid across frames.
+         * @return Id used to declare dependencies and, after compiling, to query the node.
+         */
+        NodeId add(std::string name,
+                   std::function<void()> job,
+                   std::span<const NodeId> dependencies = {},
+                   soul::async::TaskPriority priority = soul::async::TaskPriority::High);
+
+        /**
+         * @brief Declares that `node` runs only after `dependency` finished. Ids may refer to
+         *        nodes added later; everything is validated by `compile`.
+         */
+        Builder& depends_on(NodeId node, NodeId dependency);
+
+        /**
+         * @brief Validates and sorts the graph.
+         * @throws std::invalid_argument on an unknown id, a duplicate name or a cycle (the
+         *         message names the nodes involved).
+         */
+        [[nodiscard]] FrameGraph compile(std::shared_ptr<soul::async::TaskScheduler> scheduler) const;
+
+    private:
+        struct PendingNode {
+            std::string name;
+            std::function<void()> job;
+            soul::async::TaskPriority priority;
+        };
+
+        std::vector<PendingNode> m_nodes;
+        // (node, dependency) pairs, unvalidated.
+        std::vector<std::pair<NodeId, NodeId>> m_edges;
+    };
+
+    /**
+     * @brief A moved-from graph behaves as an empty one: `size` is 0, `dispatch` and `wait`
+     *        return at once, and `name` throws `std::out_of_range`.
+     */
+    FrameGraph(FrameGraph&&) noexcept;
+    /**
+     * @brief Waits for this graph's current replay, as the destructor does, before taking `other`.
+     */
+    FrameGraph& operator=(FrameGraph&& other) noexcept;
+    ~FrameGraph();
+
+    /**
+     * @brief Starts one replay: queues every node without dependencies and returns.
+     * @throws std::logic_error if the previous replay has not been waited for.
+     */
+    void dispatch();
+
+    /**
+     * @brief Blocks until the current replay finishes.
+     * @details Every node runs even if one of its dependencies threw; the first exception of the
+     *          replay is rethrown here.
+     */
+    void wait();
+
+    /**
+     * @brief `dispatch` followed by `wait`.
+     */
+    void execute();
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    [[nodiscard]] const std::string& name(NodeId node) const;
+
+    /**
+     * @brief Builder ids in the order the graph was laid out (a topological order).
+     */
+    [[nodiscard]] std::vector<NodeId> topological_order() const;
+
+private:
+    struct Compiled;
+    struct NodeJob;
+
+    explicit FrameGraph(std::unique_ptr<Compiled> compiled) noexcept;
+
+    static void enqueue_node(Compiled& graph, std::uint32_t index) noexcept;
+    static void run_node(Compiled& graph, std::uint32_t index) noexcept;
+
+    // Heap-allocated so queued jobs can keep pointing at it when the graph object is moved.
+    std::unique_ptr<Compiled> m_compiled;
+};
+
+} // namespace soul::time
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -17,9 +21,80 @@ namespace soul::time {
  *          so systems can register jobs by name, express explicit dependencies, and defer
  *          execution by a fixed duration. Tokens returned from `schedule` or `schedule_after`
  *          can be passed to other systems or reused in subsequent frames to build DAGs.
+ *          Frame jobs run on the `TaskPriority::High` lane; delays are timer-wheel entries, so
+ *          deferred jobs hold no worker while they wait.
+ *
+ *          Every job is scheduled with its own cancellation token. Scheduling a name again
+ *          supersedes the previous job: if it has not started it is skipped (completing with
+ *          `OperationCancelled`), and its dependents are released straight away.
+ *
+ *          Job names double as task labels in the timeline of a `Tracer` attached to the shared
+ *          scheduler.
+ *
+ *          With `set_graph_recording(true)` the scheduler also records the frame's graph: one node
+ *          per job with its dependency edges and measured start/finish times. `snapshot` copies
+ *          it out, e.g. for `DagVisualizer`. Recording wraps every job in a timing coroutine and
+ *          keeps a record per job, so it is off by default and jobs are scheduled as they are.
+ *          A frame is everything scheduled since the previous `wait_for_all`, or since
+ *          `begin_frame` when frames are delimited explicitly.
+ *
+ *          Names live in a slot table that `end_frame` recycles: it drops every finished job's
+ *          token (and with it the task state) and returns the slots, name buffers included, for
+ *          the next frame. Memory then stays bounded by the jobs of one frame, even when names
+ *          are unique per frame. `wait_for_all` only visits jobs scheduled since the previous
+ *          call.
  */
 class FrameScheduler {
 public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class NodeState : std::uint8_t {
+        Pending,   ///< Waiting for dependencies, a delay or a worker.
+        Running,
+        Completed, ///< Finished, successfully or by throwing.
+        Cancelled, ///< Superseded or cancelled before it started.
+    };
+
+    /**
+     * @brief One job of a frame graph. Times are relative to the frame's first `schedule` call.
+     */
+    struct GraphNode {
+        std::uint32_t id{0};
+        std::string name;
+        /// Ids of dependencies scheduled in the same frame; always lower than `id`.
+        std::vector<std::uint32_t> dependencies;
+        NodeState state{NodeState::Pending};
+        std::chrono::nanoseconds scheduledAt{0};
+        /// Zero until the job starts.
+        std::chrono::nanoseconds startedAt{0};
+        /// Zero until the job finishes.
+        std::chrono::nanoseconds finishedAt{0};
+
+        [[nodiscard]] std::chrono::nanoseconds duration() const noexcept {
+            return state == NodeState::Completed ? finishedAt - startedAt : std::chrono::nanoseconds{0};
+        }
+    };
+
+    /**
+     * @brief Copy of a frame graph taken by `snapshot`. Node ids index `nodes`.
+     */
+    struct GraphSnapshot {
+        /// Counts frames from 0; advances with the first `schedule` after each `wait_for_all`.
+        std::uint64_t frame{0};
+        std::vector<GraphNode> nodes;
+
+        /**
+         * @brief Measured critical path: from the job that finished last, repeatedly to the
+         *        dependency that finished last, listed in execution order.
+         */
+        [[nodiscard]] std::vector<std::uint32_t> critical_path() const;
+
+        /**
+         * @brief Time from the frame's first `schedule` to its last finished job.
+         */
+        [[nodiscard]] std::chrono::nanoseconds makespan() const noexcept;
+    };
+
     struct TaskHandle {
         /**
          * @brief Awaitable instance tied to the shared scheduler.
@@ -55,6 +130,33 @@ public:
                                             soul::async::Task<void> task,
                                             std::span<const soul::async::TaskToken> dependencies = {});
 
+    /**
+     * @brief Cancels the job registered under `name` if it has not started yet.
+     * @return `true` if a job with that name was known and had not been cancelled before.
+     */
+    bool cancel(const std::string& name);
+
+    /**
+     * @brief Starts a frame: ends the previous one (see `end_frame`) and restarts the graph, so
+     *        recorded times count from here.
+     * @return Number of the new frame, as reported by `GraphSnapshot::frame`.
+     */
+    std::uint64_t begin_frame();
+
+    /**
+     * @brief `wait_for_all`, then forgets every job name: tokens are released, slots recycled,
+     *        and `cancel` on those names returns `false`. The frame's graph stays available to
+     *        `snapshot` until the next frame starts.
+     */
+    void end_frame();
+
+    /**
+     * @brief Number of job names currently registered.
+     */
+    [[nodiscard]] std::size_t tracked_jobs() const noexcept {
+        return m_jobIds.size();
+    }
+
     /**
      * @brief Blocks until all in-flight frame tasks reach completion.
      * @note Useful during shutdown or validation scenarios where deterministic completion is
@@ -62,9 +164,76 @@ public:
      */
     void wait_for_all();
 
+    /**
+     * @brief Turns frame graph recording on or off for jobs scheduled from now on.
+     */
+    void set_graph_recording(bool enabled) noexcept {
+        m_recordGraph = enabled;
+    }
+
+    [[nodiscard]] bool graph_recording() const noexcept {
+        return m_recordGraph;
+    }
+
+    /**
+     * @brief Copies the current frame's graph; jobs still running show their state so far.
+     *        Empty unless graph recording is on.
+     */
+    [[nodiscard]] GraphSnapshot snapshot() const;
+
 private:
+    // Written by the job's worker, read by `snapshot`; times are nanoseconds since the frame start.
+    struct GraphRecord {
+        std::string name;
+        std::vector<std::uint32_t> dependencies;
+        std::int64_t scheduledAt{0};
+        std::atomic_int64_t startedAt{-1};
+        std::atomic_int64_t finishedAt{-1};
+        bool cancelled{false};
+    };
+
+    struct TrackedJob {
+        // Owns the storage `m_jobIds` keys point into; kept when the slot is recycled.
+        std::string name;
+        soul::async::TaskToken token;
+        soul::async::CancellationSource cancellation;
+        // Valid while `frame` is the current frame; null when the job was not recorded.
+        GraphRecord* record{nullptr};
+        std::uint64_t frame{0};
+        // Scheduled since the last `wait_for_all`, i.e. listed in `m_live`.
+        bool live{false};
+    };
+
+    static soul::async::Task<void> run_recorded(soul::async::Task<void> task, GraphRecord& record, Clock::time_point frameStart);
+
+    void open_frame();
+    // Opens the frame if needed; returns the job's graph record, or null when not recording.
+    GraphRecord* begin_job(const std::string& name, std::span<const soul::async::TaskToken> dependencies);
+    TaskHandle track(const std::string& name,
+                     soul::async::Task<void> scheduled,
+                     soul::async::CancellationSource cancellation,
+                     GraphRecord* record);
+
     std::shared_ptr<soul::async::TaskScheduler> m_scheduler;
-    std::unordered_map<std::string, soul::async::TaskToken> m_tokens;
+    // Slots indexed by `m_jobIds`; a deque so names keep their address as it grows.
+    std::deque<TrackedJob> m_jobs;
+    std::unordered_map<std::string_view, std::uint32_t> m_jobIds;
+    std::vector<std::uint32_t> m_freeJobs;
+    // Slots scheduled since the last `wait_for_all`.
+    std::vector<std::uint32_t> m_live;
+    // Jobs replaced by a later one with the same name; still waited on by `wait_for_all`.
+    std::vector<soul::async::TaskToken> m_superseded;
+
+    // Current frame graph; a deque so records stay put while their jobs write to them.
+    std::deque<GraphRecord> m_graph;
+    std::unordered_map<const void*, std::uint32_t> m_graphIds;
+    Clock::time_point m_frameStart{};
+    std::uint64_t m_frame{0};
+    // Cleared by `wait_for_all`; the next `schedule` then starts a new frame.
+    bool m_frameOpen{false};
+    // Whether the current frame has scheduled anything, so the next one counts as a new frame.
+    bool m_frameUsed{false};
+    bool m_recordGraph{false};
 };
 
 } // namespace soul::time
@@ -0,0 +1,71 @@
+#include "Async/Cancellation.h"
+
+namespace soul::async::detail {
+
+bool CancellationRegistration::arm(const std::shared_ptr<CancellationState>& state, Callback callback, void* context) {
+    disarm();
+    if (!state) {
+        return true;
+    }
+
+    std::lock_guard lock(state->mutex);
+    if (state->requested.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    m_state = state;
+    m_callback = callback;
+    m_context = context;
+    m_prev = nullptr;
+    m_next = state->callbacks;
+    if (m_next) {
+        m_next->m_prev = this;
+    }
+    state->callbacks = this;
+    m_linked = true;
+    return true;
+}
+
+void CancellationRegistration::disarm() noexcept {
+    if (!m_state) {
+        return;
+    }
+
+    {
+        // Taking the lock also waits out a callback that `request` may be running right now.
+        std::lock_guard lock(m_state->mutex);
+        if (m_linked) {
+            if (m_prev) {
+                m_prev->m_next = m_next;
+            } else {
+                m_state->callbacks = m_next;
+            }
+            if (m_next) {
+                m_next->m_prev = m_prev;
+            }
+            m_linked = false;
+        }
+    }
+    m_state.reset();
+}
+
+bool CancellationState::request() {
+    std::lock_guard lock(mutex);
+    if (requested.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    auto* registration = callbacks;
+    callbacks = nullptr;
+    while (registration) {
+        // Read everything first: the callback may let the owner of the entry move on.
+        auto* next = registration->m_next;
+        const auto callback = registration->m_callback;
+        auto* context = registration->m_context;
+        registration->m_linked = false;
+        callback(context);
+        registration = next;
+    }
+    return true;
+}
+
+} // namespace soul::async::detail
@@ -0,0 +1,181 @@
+#include "Async/FrameAllocator.h"
+
+#include <array>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+#include "Memory/Core/PoolAllocator.h"
+
+namespace soul::async::detail {
+
+namespace {
+
+constexpr std::size_t kClassSizes[] = {64, 128, 256, 512, 1024, 2048};
+constexpr std::size_t kClassCount = std::size(kClassSizes);
+// Blocks move between thread caches and the shared depot in batches of this size.
+constexpr std::size_t kBatch = 32;
+constexpr std::size_t kMaxCached = 2 * kBatch;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+template <std::size_t Size>
+struct alignas(std::max_align_t) Block {
+    std::byte bytes[Size];
+};
+
+constexpr std::size_t class_index(std::size_t size) noexcept {
+    for (std::size_t i = 0; i < kClassCount; ++i) {
+        if (size <= kClassSizes[i]) {
+            return i;
+        }
+    }
+    return kClassCount;
+}
+
+/**
+ * @brief Shared free list for one size class, refilled from `PoolAllocator` slabs.
+ */
+class Depot {
+public:
+    virtual ~Depot() = default;
+
+    FreeBlock* take(std::size_t count) {
+        std::lock_guard lock(m_mutex);
+        FreeBlock* head = nullptr;
+        for (std::size_t i = 0; i < count; ++i) {
+            FreeBlock* block = m_freeList;
+            if (block) {
+                m_freeList = block->next;
+            } else {
+                block = static_cast<FreeBlock*>(carve());
+            }
+            block->next = head;
+            head = block;
+        }
+        return head;
+    }
+
+    void give(FreeBlock* head, FreeBlock* tail) noexcept {
+        std::lock_guard lock(m_mutex);
+        tail->next = m_freeList;
+        m_freeList = head;
+    }
+
+protected:
+    virtual void* carve() = 0;
+
+private:
+    std::mutex m_mutex;
+    FreeBlock* m_freeList{nullptr};
+};
+
+template <std::size_t Size>
+class SlabDepot final : public Depot {
+    static constexpr std::size_t kBlocksPerSlab = (16 * 1024) / Size < 16 ? 16 : (16 * 1024) / Size;
+    using Slab = Memory::Core::PoolAllocator<Block<Size>, kBlocksPerSlab>;
+
+    void* carve() override {
+        if (m_slabs.empty() || m_slabs.back()->available() == 0) {
+            // Slabs are never released: frames may be freed after the thread that allocated them
+            // has exited, and the pool must stay valid through static destruction.
+            m_slabs.push_back(new Slab(SOUL_MEMORY_TAG("CoroutineFrame")));
+        }
+        return m_slabs.back()->allocate();
+    }
+
+    std::vector<Slab*> m_slabs;
+};
+
+Depot& depot(std::size_t index) {
+    // Deliberately leaked for the same reason as the slabs.
+    static const std::array<Depot*, kClassCount> depots{
+        new SlabDepot<64>(), new SlabDepot<128>(), new SlabDepot<256>(),
+        new SlabDepot<512>(), new SlabDepot<1024>(), new SlabDepot<2048>(),
+    };
+    return *depots[index];
+}
+
+struct ThreadCache {
+    struct Bin {
+        FreeBlock* head{nullptr};
+        std::size_t count{0};
+    };
+
+    ThreadCache() = default;
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    ~ThreadCache() {
+        for (std::size_t i = 0; i < kClassCount; ++i) {
+            auto& bin = bins[i];
+            if (!bin.head) {
+                continue;
+            }
+            FreeBlock* tail = bin.head;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            depot(i).give(bin.head, tail);
+            bin = {};
+        }
+    }
+
+    std::array<Bin, kClassCount> bins{};
+};
+
+thread_local ThreadCache t_cache;
+
+} // namespace
+
+void* allocate_frame(std::size_t size) {
+    const auto index = class_index(size);
+    if (index == kClassCount) {
+        return ::operator new(size);
+    }
+
+    auto& bin = t_cache.bins[index];
+    if (!bin.head) {
+        bin.head = depot(index).take(kBatch);
+        bin.count = kBatch;
+    }
+
+    FreeBlock* block = bin.head;
+    bin.head = block->next;
+    --bin.count;
+    return block;
+}
+
+void deallocate_frame(void* ptr, std::size_t size) noexcept {
+    if (!ptr) {
+        return;
+    }
+
+    const auto index = class_index(size);
+    if (index == kClassCount) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto& bin = t_cache.bins[index];
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = bin.head;
+    bin.head = block;
+    if (++bin.count <= kMaxCached) {
+        return;
+    }
+
+    // Return a batch so blocks freed on consumer threads flow back to producer threads.
+    FreeBlock* tail = bin.head;
+    for (std::size_t i = 1; i < kBatch; ++i) {
+        tail = tail->next;
+    }
+    FreeBlock* batch = bin.head;
+    bin.head = tail->next;
+    bin.count -= kBatch;
+    depot(index).give(batch, tail);
+}
+
+} // namespace soul::async::detail
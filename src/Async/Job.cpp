@@ -0,0 +1,41 @@
+#include "Async/Job.h"
+
+namespace soul::async::detail {
+
+void* JobStoragePool::allocate(std::size_t size, std::size_t alignment) {
+    if (size > kBlockSize || alignment > alignof(std::max_align_t)) {
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (!m_freeList) {
+        auto slab = std::make_unique<Block[]>(kBlocksPerSlab);
+        for (std::size_t i = 0; i < kBlocksPerSlab; ++i) {
+            auto* block = reinterpret_cast<FreeBlock*>(&slab[i]);
+            block->next = m_freeList;
+            m_freeList = block;
+        }
+        m_slabs.emplace_back(std::move(slab));
+    }
+
+    FreeBlock* block = m_freeList;
+    m_freeList = block->next;
+    return block;
+}
+
+void JobStoragePool::deallocate(void* ptr, std::size_t size, std::size_t alignment) noexcept {
+    if (!ptr) {
+        return;
+    }
+    if (size > kBlockSize || alignment > alignof(std::max_align_t)) {
+        ::operator delete(ptr, std::align_val_t(alignment));
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = m_freeList;
+    m_freeList = block;
+}
+
+} // namespace soul::async::detail
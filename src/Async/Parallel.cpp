@@ -0,0 +1,126 @@
+#include "Async/Parallel.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace soul::async::detail {
+
+namespace {
+
+// Automatic grains aim for this many chunks per participant before guided splitting kicks in.
+constexpr std::size_t kChunksPerParticipant = 16;
+
+struct LoopState {
+    LoopState(std::size_t count, std::size_t grain, std::size_t participants,
+              ParallelLoop::ChunkFunction function, void* context) noexcept
+        : count(count), grain(grain), participants(participants), function(function), context(context) {}
+
+    const std::size_t count;
+    const std::size_t grain;
+    const std::size_t participants;
+    const ParallelLoop::ChunkFunction function;
+    void* const context;
+
+    std::atomic_size_t next{0};
+    std::atomic_size_t done{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    bool claim(std::size_t& begin, std::size_t& end) noexcept {
+        std::size_t current = next.load(std::memory_order_relaxed);
+        do {
+            if (current >= count) {
+                return false;
+            }
+            const auto remaining = count - current;
+            const auto size = std::min(remaining, std::max(grain, remaining / (2 * participants)));
+            begin = current;
+            end = current + size;
+        } while (!next.compare_exchange_weak(current, end, std::memory_order_relaxed));
+        return true;
+    }
+
+    void finish(std::size_t processed) noexcept {
+        if (done.fetch_add(processed, std::memory_order_acq_rel) + processed == count) {
+            done.notify_all();
+        }
+    }
+
+    void work() noexcept {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        while (claim(begin, end)) {
+            try {
+                function(context, begin, end);
+            } catch (...) {
+                {
+                    std::lock_guard lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                // Cancel whatever nobody has claimed yet and account for it as finished.
+                const auto unclaimed = next.exchange(count, std::memory_order_relaxed);
+                if (unclaimed < count) {
+                    finish(count - unclaimed);
+                }
+            }
+            finish(end - begin);
+        }
+    }
+
+    void wait() const noexcept {
+        auto current = done.load(std::memory_order_acquire);
+        while (current != count) {
+            done.wait(current, std::memory_order_acquire);
+            current = done.load(std::memory_order_acquire);
+        }
+    }
+};
+
+} // namespace
+
+void ParallelLoop::run(TaskScheduler& scheduler,
+                       std::size_t count,
+                       const ParallelOptions& options,
+                       ChunkFunction function,
+                       void* context) {
+    if (count == 0) {
+        return;
+    }
+
+    const auto workers = scheduler.worker_count();
+    const auto participants = workers + 1;
+    const auto grain = options.grainSize != 0
+                           ? options.grainSize
+                           : std::max<std::size_t>(1, count / (participants * kChunksPerParticipant));
+    const auto chunks = (count + grain - 1) / grain;
+    if (chunks < 2 || workers == 0) {
+        function(context, 0, count);
+        return;
+    }
+
+    // Helpers capture the state by shared pointer: one that starts after the loop has finished
+    // finds nothing to claim and never touches the caller's (by then destroyed) context.
+    auto state = std::make_shared<LoopState>(count, grain, participants, function, context);
+    const auto helpers = std::min(workers, chunks - 1);
+    TaskScheduler::JobBatch batch;
+    try {
+        for (std::size_t i = 0; i < helpers; ++i) {
+            batch.append(scheduler.make_job_node([state]() { state->work(); }));
+        }
+    } catch (...) {
+        // Fewer helpers only means the caller claims more chunks itself.
+    }
+    scheduler.push_batch(batch, options.priority);
+
+    state->work();
+    state->wait();
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace soul::async::detail
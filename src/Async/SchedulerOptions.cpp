@@ -0,0 +1,160 @@
+#include "Async/SchedulerOptions.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#elif defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
+namespace soul::async {
+
+namespace {
+
+[[maybe_unused]] std::vector<NumaNode> single_node() {
+    NumaNode node;
+    const auto count = std::max(1u, std::thread::hardware_concurrency());
+    for (std::uint32_t cpu = 0; cpu < count; ++cpu) {
+        node.cpus.push_back(cpu);
+    }
+    return {std::move(node)};
+}
+
+#if defined(__linux__)
+// Parses a sysfs CPU list such as "0-3,8-11".
+CpuSet parse_cpu_list(std::string_view list) {
+    CpuSet cpus;
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        const auto range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        const auto dash = range.find('-');
+        std::uint32_t first = 0;
+        std::uint32_t last = 0;
+        const auto head = range.substr(0, dash);
+        if (std::from_chars(head.data(), head.data() + head.size(), first).ec != std::errc{}) {
+            continue;
+        }
+        last = first;
+        if (dash != std::string_view::npos) {
+            const auto tail = range.substr(dash + 1);
+            if (std::from_chars(tail.data(), tail.data() + tail.size(), last).ec != std::errc{}) {
+                continue;
+            }
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+#endif
+
+} // namespace
+
+std::vector<NumaNode> numa_topology() {
+#if defined(__linux__)
+    std::vector<NumaNode> nodes;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        const auto name = entry.path().filename().string();
+        std::uint32_t id = 0;
+        if (name.rfind("node", 0) != 0 ||
+            std::from_chars(name.data() + 4, name.data() + name.size(), id).ec != std::errc{}) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!std::getline(file, list)) {
+            continue;
+        }
+        auto cpus = parse_cpu_list(list);
+        if (!cpus.empty()) {
+            nodes.push_back(NumaNode{id, std::move(cpus)});
+        }
+    }
+    if (nodes.empty()) {
+        return single_node();
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+    return nodes;
+#elif defined(_WIN32)
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) {
+        return single_node();
+    }
+    std::vector<NumaNode> nodes;
+    for (ULONG id = 0; id <= highest; ++id) {
+        ULONGLONG mask = 0;
+        if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(id), &mask) || mask == 0) {
+            continue;
+        }
+        NumaNode node{static_cast<std::uint32_t>(id), {}};
+        for (std::uint32_t cpu = 0; cpu < 64; ++cpu) {
+            if (mask & (ULONGLONG{1} << cpu)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        nodes.push_back(std::move(node));
+    }
+    return nodes.empty() ? single_node() : nodes;
+#else
+    return single_node();
+#endif
+}
+
+bool pin_current_thread(const CpuSet& cpus) noexcept {
+    if (cpus.empty()) {
+        return false;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    // Processor groups are not handled: only the first 64 CPUs can be selected.
+    DWORD_PTR mask = 0;
+    for (const auto cpu : cpus) {
+        if (cpu < sizeof(DWORD_PTR) * 8) {
+            mask |= DWORD_PTR{1} << cpu;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    return false;
+#endif
+}
+
+std::optional<std::uint32_t> current_cpu() noexcept {
+#if defined(__linux__)
+    const auto cpu = sched_getcpu();
+    if (cpu < 0) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(cpu);
+#elif defined(_WIN32)
+    return static_cast<std::uint32_t>(GetCurrentProcessorNumber());
+#else
+    return std::nullopt;
+#endif
+}
+
+} // namespace soul::async
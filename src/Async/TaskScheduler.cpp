@@ -1,60 +1,462 @@
 #include "Async/Task.h"
+#include "Async/WorkStealingDeque.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#endif
 
 namespace soul::async {
 
+namespace {
+
+// Nodes move between per-worker caches and the shared free list in batches of this size.
+constexpr std::size_t kNodeBatch = 32;
+constexpr std::size_t kNodesPerSlab = 128;
+
+// Deadline work climbs one lane when this close to its deadline and reaches the high lane
+// within one window.
+constexpr auto kDeadlinePromotionWindow = std::chrono::milliseconds(2);
+
+// Resolution of the timer wheel; timers fire on the first tick at or after their wake time.
+using TimerTick = std::chrono::milliseconds;
+
+// Tells the core this is a busy-wait loop, freeing pipeline resources for a sibling hyperthread.
+inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+Task<void> delay_until(TaskScheduler& scheduler,
+                       TaskScheduler::Clock::time_point startTime,
+                       TaskPriority priority,
+                       CancellationToken cancellation) {
+    co_await scheduler.sleep_until(startTime, cancellation, priority);
+}
+
+std::size_t effective_lane(TaskPriority base, std::chrono::steady_clock::duration remaining) noexcept {
+    const auto lane = static_cast<std::size_t>(base);
+    if (remaining <= kDeadlinePromotionWindow) {
+        return 0;
+    }
+    if (remaining <= 2 * kDeadlinePromotionWindow) {
+        return lane > 0 ? lane - 1 : 0;
+    }
+    return lane;
+}
+
+SchedulerOptions options_for(std::size_t workerCount) {
+    SchedulerOptions options;
+    options.workerCount = workerCount;
+    return options;
+}
+
+} // namespace
+
 class TaskScheduler::Worker {
 public:
-    explicit Worker(TaskScheduler& owner)
+    Worker(TaskScheduler& owner, std::size_t index, std::size_t group, CpuSet cpus)
         : m_owner(owner),
-          m_thread([this]() { run(); }) {}
+          m_index(index),
+          m_group(group),
+          m_cpus(std::move(cpus)),
+          m_rngState(static_cast<std::uint32_t>(index) * 0x9E3779B9u + 1u) {}
 
     Worker(const Worker&) = delete;
     Worker& operator=(const Worker&) = delete;
 
     ~Worker() {
+        join();
+    }
+
+    void start() {
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    void join() {
         if (m_thread.joinable()) {
             m_thread.join();
         }
     }
 
+    /**
+     * @brief Returns the worker bound to the calling thread if it belongs to `owner`.
+     */
+    static Worker* current(const TaskScheduler* owner) noexcept {
+        return (s_current && &s_current->m_owner == owner) ? s_current : nullptr;
+    }
+
+    /**
+     * @brief Returns the worker bound to the calling thread, whichever scheduler owns it.
+     */
+    static Worker* running() noexcept {
+        return s_current;
+    }
+
+    [[nodiscard]] TaskScheduler& owner() const noexcept {
+        return m_owner;
+    }
+
+    [[nodiscard]] std::size_t index() const noexcept {
+        return m_index;
+    }
+
+    void push_local(detail::JobNode* node, std::size_t lane) {
+        m_deques[lane].push(node);
+    }
+
+    std::optional<detail::JobNode*> steal(std::size_t lane) {
+        return m_deques[lane].steal();
+    }
+
+    [[nodiscard]] bool has_jobs(std::size_t lane) const noexcept {
+        return !m_deques[lane].empty();
+    }
+
+    [[nodiscard]] bool has_jobs() const noexcept {
+        return std::any_of(m_deques.begin(), m_deques.end(), [](const auto& deque) { return !deque.empty(); });
+    }
+
+    [[nodiscard]] std::size_t group() const noexcept {
+        return m_group;
+    }
+
+    void collect(WorkerMetrics& metrics) const noexcept {
+        metrics.group = static_cast<std::uint32_t>(m_group);
+        for (const auto& deque : m_deques) {
+            metrics.queueDepth += deque.size();
+        }
+#if SOULLIB_SCHEDULER_METRICS
+        metrics.jobsExecuted = m_counters.jobsExecuted.load();
+        metrics.steals = m_counters.steals.load();
+        metrics.wakeUps = m_counters.wakeUps.load();
+        metrics.spinHits = m_counters.spinHits.load();
+        metrics.idleTime = std::chrono::nanoseconds(static_cast<std::int64_t>(m_counters.idleNanoseconds.load()));
+        metrics.busyTime = std::chrono::nanoseconds(static_cast<std::int64_t>(m_counters.busyNanoseconds.load()));
+        metrics.queueLatency = m_counters.queueLatency.snapshot();
+        metrics.executionTime = m_counters.executionTime.snapshot();
+#endif
+    }
+
+    detail::JobNode* acquire_node() {
+        if (!m_freeNodes) {
+            m_freeNodes = m_owner.refill_nodes(kNodeBatch);
+            m_freeCount = kNodeBatch;
+        }
+        auto* node = m_freeNodes;
+        m_freeNodes = node->next;
+        node->next = nullptr;
+        --m_freeCount;
+        return node;
+    }
+
+    void release_node(detail::JobNode* node) noexcept {
+        node->next = m_freeNodes;
+        m_freeNodes = node;
+        if (++m_freeCount <= 2 * kNodeBatch) {
+            return;
+        }
+
+        // Hand a batch back so nodes freed by thieves flow back to producers.
+        auto* head = m_freeNodes;
+        auto* tail = head;
+        for (std::size_t i = 1; i < kNodeBatch; ++i) {
+            tail = tail->next;
+        }
+        m_freeNodes = tail->next;
+        m_freeCount -= kNodeBatch;
+        m_owner.return_nodes(head, tail);
+    }
+
 private:
     void run() {
+        if (!m_cpus.empty()) {
+            pin_current_thread(m_cpus);
+        }
+        s_current = this;
         while (m_owner.m_running.load(std::memory_order_acquire)) {
-            std::function<void()> job;
-            {
-                std::unique_lock lock(m_owner.m_queueMutex);
-                m_owner.m_queueCv.wait(lock, [&]() {
-                    return !m_owner.m_running.load(std::memory_order_acquire) || !m_owner.m_jobs.empty();
-                });
-
-                if (!m_owner.m_running.load(std::memory_order_acquire) && m_owner.m_jobs.empty()) {
-                    return;
+            if (auto* node = find_job()) {
+                execute(node);
+                continue;
+            }
+            if (auto* node = spin()) {
+                execute(node);
+                continue;
+            }
+            park();
+        }
+        s_current = nullptr;
+    }
+
+    detail::JobNode* find_job() {
+        // A lane is exhausted everywhere, other workers included, before a lower one is touched.
+        for (std::size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+            if (auto* node = m_owner.take_deadline_job(lane)) {
+                return node;
+            }
+            if (auto node = m_deques[lane].pop()) {
+                return *node;
+            }
+            if (auto* node = m_owner.take_injected_job(lane, m_group)) {
+                return node;
+            }
+            if (auto* node = steal_from_victims(lane)) {
+                return node;
+            }
+            if (auto* node = m_owner.take_remote_injected_job(lane, m_group)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    detail::JobNode* steal_from_victims(std::size_t lane) {
+        const auto count = m_owner.m_workers.size();
+        if (count < 2) {
+            return nullptr;
+        }
+
+        // With several groups, victims on this worker's node go first.
+        const bool grouped = m_owner.m_injection.size() > 1;
+        const auto start = next_random() % count;
+        for (int pass = 0; pass < (grouped ? 2 : 1); ++pass) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& victim = m_owner.m_workers[(start + i) % count];
+                if (victim.get() == this || (grouped && (victim->m_group == m_group) != (pass == 0)) ||
+                    !victim->has_jobs(lane)) {
+                    continue;
                 }
+                if (auto node = victim->steal(lane)) {
+#if SOULLIB_SCHEDULER_METRICS
+                    m_counters.steals.add(1);
+#endif
+                    return *node;
+                }
+            }
+        }
+        return nullptr;
+    }
 
-                job = std::move(m_owner.m_jobs.front());
-                m_owner.m_jobs.pop_front();
+    // Keeps polling for a while before parking, so work that arrives shortly after this worker
+    // ran dry is picked up without a park and wake-up.
+    detail::JobNode* spin() {
+        const auto& policy = m_owner.m_parking;
+        const auto rounds = policy.spinRounds + policy.yieldRounds;
+        if (rounds == 0) {
+            return nullptr;
+        }
+        auto spinning = m_owner.m_spinningWorkers.load(std::memory_order_relaxed);
+        do {
+            if (spinning >= policy.maxSpinningWorkers) {
+                return nullptr;
             }
+        } while (!m_owner.m_spinningWorkers.compare_exchange_weak(spinning, spinning + 1, std::memory_order_seq_cst));
 
-            if (job) {
-                job();
+        detail::JobNode* node = nullptr;
+        for (std::uint32_t round = 0; round < rounds && m_owner.m_running.load(std::memory_order_acquire); ++round) {
+            if (round < policy.spinRounds) {
+                cpu_relax();
+            } else {
+                std::this_thread::yield();
             }
+            if ((node = find_job()) != nullptr) {
+                break;
+            }
+        }
+        // Submitters that saw this worker polling skipped their wake-up; park() re-checks the
+        // queues after this decrement, so none of their jobs can be missed.
+        m_owner.m_spinningWorkers.fetch_sub(1, std::memory_order_seq_cst);
+        if (node) {
+#if SOULLIB_SCHEDULER_METRICS
+            m_counters.spinHits.add(1);
+#endif
+            // More work may have been submitted while this worker was the only one looking.
+            if (m_owner.has_visible_jobs()) {
+                m_owner.wake_one_worker();
+            }
+        }
+        return node;
+    }
+
+    void park() {
+        std::unique_lock lock(m_owner.m_queueMutex);
+        m_owner.m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the fence in wake_one_worker: either the producer observes this sleeper or
+        // the predicate below observes the freshly pushed job.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto ready = [this]() {
+            return !m_owner.m_running.load(std::memory_order_acquire) || m_owner.has_visible_jobs();
+        };
+        if (!ready()) {
+#if SOULLIB_SCHEDULER_METRICS
+            const auto parkedAt = Clock::now();
+#endif
+            m_owner.m_queueCv.wait(lock, ready);
+#if SOULLIB_SCHEDULER_METRICS
+            m_counters.wakeUps.add(1);
+            m_counters.idleNanoseconds.add(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - parkedAt).count()));
+#endif
         }
+        m_owner.m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
     }
 
+    void execute(detail::JobNode* node) {
+#if SOULLIB_SCHEDULER_METRICS
+        const auto started = Clock::now();
+        m_counters.queueLatency.record(started - node->enqueuedAt);
+#endif
+        auto* tracer = m_owner.active_tracer();
+        Clock::time_point traceStart{};
+        if (tracer) {
+            if (tracer != m_namedTracer) {
+                tracer->set_thread_name("worker " + std::to_string(m_index));
+                m_namedTracer = tracer;
+            }
+            traceStart = Clock::now();
+        }
+        if (node->job) {
+            node->job();
+        }
+        if (tracer) {
+            tracer->slice("job", traceStart, Clock::now());
+        }
+#if SOULLIB_SCHEDULER_METRICS
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started);
+        m_counters.executionTime.record(elapsed);
+        m_counters.busyNanoseconds.add(static_cast<std::uint64_t>(elapsed.count()));
+        m_counters.jobsExecuted.add(1);
+#endif
+        m_owner.release_node(node);
+    }
+
+    std::uint32_t next_random() noexcept {
+        // xorshift32: cheap victim selection that stays thread-local.
+        m_rngState ^= m_rngState << 13;
+        m_rngState ^= m_rngState >> 17;
+        m_rngState ^= m_rngState << 5;
+        return m_rngState;
+    }
+
+    static inline thread_local Worker* s_current = nullptr;
+
     TaskScheduler& m_owner;
+    std::size_t m_index;
+    std::size_t m_group;
+    CpuSet m_cpus;
+    // Tracer this worker last labelled its track in.
+    Tracer* m_namedTracer{nullptr};
+    std::array<detail::WorkStealingDeque<detail::JobNode*>, kTaskPriorityCount> m_deques;
+    detail::JobNode* m_freeNodes{nullptr};
+    std::size_t m_freeCount{0};
+    std::uint32_t m_rngState;
     std::thread m_thread;
+#if SOULLIB_SCHEDULER_METRICS
+    detail::WorkerCounters m_counters;
+#endif
 };
 
-TaskScheduler::TaskScheduler(std::size_t workerCount) {
+TaskScheduler* current_scheduler() noexcept {
+    auto* worker = TaskScheduler::Worker::running();
+    return worker ? &worker->owner() : nullptr;
+}
+
+std::optional<std::size_t> current_worker() noexcept {
+    auto* worker = TaskScheduler::Worker::running();
+    return worker ? std::optional<std::size_t>(worker->index()) : std::nullopt;
+}
+
+TaskScheduler::TaskScheduler(std::size_t workerCount)
+    : TaskScheduler(options_for(workerCount)) {}
+
+TaskScheduler::TaskScheduler(const SchedulerOptions& options) {
+    auto workerCount = options.workerCount;
     if (workerCount == 0) {
         workerCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
     }
+
+    std::vector<CpuSet> placement(workerCount);
+    std::vector<std::size_t> groups(workerCount, 0);
+    std::size_t groupCount = 1;
+    if (options.numaAware) {
+        const auto nodes = numa_topology();
+        std::vector<std::size_t> nodeOfCpu;
+        for (std::size_t node = 0; node < nodes.size(); ++node) {
+            for (const auto cpu : nodes[node].cpus) {
+                nodeOfCpu.resize(std::max<std::size_t>(nodeOfCpu.size(), cpu + 1), 0);
+                nodeOfCpu[cpu] = node;
+            }
+        }
+
+        // Nodes become groups in the order they first receive a worker.
+        std::vector<std::optional<std::size_t>> groupOfNode(nodes.size());
+        groupCount = 0;
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            std::size_t node = i * nodes.size() / workerCount;
+            if (!options.cpuSets.empty()) {
+                const auto& cpus = options.cpuSets[i % options.cpuSets.size()];
+                node = !cpus.empty() && cpus.front() < nodeOfCpu.size() ? nodeOfCpu[cpus.front()] : 0;
+            }
+            if (!groupOfNode[node]) {
+                groupOfNode[node] = groupCount++;
+            }
+            groups[i] = *groupOfNode[node];
+            placement[i] = nodes[node].cpus;
+        }
+
+        // Submissions from CPUs of nodes without workers go to group 0.
+        m_cpuGroups.assign(nodeOfCpu.size(), 0);
+        for (std::size_t cpu = 0; cpu < nodeOfCpu.size(); ++cpu) {
+            m_cpuGroups[cpu] = static_cast<std::uint32_t>(groupOfNode[nodeOfCpu[cpu]].value_or(0));
+        }
+    }
+    if (!options.cpuSets.empty()) {
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            placement[i] = options.cpuSets[i % options.cpuSets.size()];
+        }
+    }
+
+    m_parking = options.parking;
+    if (std::thread::hardware_concurrency() <= 1) {
+        m_parking.spinRounds = 0;
+    }
+    if (m_parking.maxSpinningWorkers == 0) {
+        m_parking.maxSpinningWorkers = (workerCount + 1) / 2;
+    }
+
+    m_injection.reserve(groupCount);
+    for (std::size_t group = 0; group < groupCount; ++group) {
+        m_injection.emplace_back(std::make_unique<InjectionQueue>());
+    }
     m_workers.reserve(workerCount);
     for (std::size_t i = 0; i < workerCount; ++i) {
-        m_workers.emplace_back(std::make_unique<Worker>(*this));
+        m_workers.emplace_back(std::make_unique<Worker>(*this, i, groups[i], std::move(placement[i])));
+    }
+    // Threads start only once the worker table is complete so stealing never observes a
+    // partially constructed vector.
+    for (auto& worker : m_workers) {
+        worker->start();
+    }
+
+    m_ioThreads.reserve(options.ioWorkerCount);
+    for (std::size_t i = 0; i < options.ioWorkerCount; ++i) {
+        auto cpus = options.ioCpuSets.empty() ? CpuSet{} : options.ioCpuSets[i % options.ioCpuSets.size()];
+        m_ioThreads.emplace_back([this, i, cpus = std::move(cpus)]() { run_io_worker(i, cpus); });
     }
 }
 
@@ -74,62 +476,617 @@ void TaskScheduler::run() {
 }
 
 void TaskScheduler::stop() {
-    bool expected = true;
-    if (m_running.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
-        {
-            std::lock_guard lock(m_queueMutex);
-        }
-        m_queueCv.notify_all();
-    } else {
+    {
+        std::lock_guard lock(m_queueMutex);
         m_running.store(false, std::memory_order_release);
-        m_queueCv.notify_all();
+        m_stopped.store(true, std::memory_order_release);
     }
+    m_queueCv.notify_all();
     for (auto& worker : m_workers) {
-        worker.reset();
+        worker->join();
+    }
+
+    {
+        std::lock_guard lock(m_ioMutex);
+        m_ioStopped = true;
     }
+    m_ioCv.notify_all();
+    for (auto& thread : m_ioThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    {
+        std::lock_guard lock(m_timerMutex);
+        m_timersStopped = true;
+    }
+    m_timerCv.notify_all();
+    if (m_timerThread.joinable()) {
+        m_timerThread.join();
+    }
+
+    // Nothing will run what is still queued. Destroy it now, while the queues and node pool
+    // still exist, so the jobs' captures are released instead of held until destruction: they
+    // may release tasks whose destructors reach back into the scheduler, or finish work their
+    // owner is waiting for.
+    discard_queued_jobs();
 }
 
-void TaskScheduler::enqueue(std::function<void()> job) {
+void TaskScheduler::discard_queued_jobs() noexcept {
+    // Collected under the locks and destroyed outside them, since a job's destructor may submit
+    // work (dropped now) or release other tasks.
+    std::vector<detail::JobNode*> nodes;
+    const auto collect = [&nodes](detail::JobNode* node) {
+        try {
+            nodes.push_back(node);
+        } catch (...) {
+            node->job.reset();
+        }
+    };
+    for (auto& worker : m_workers) {
+        for (std::size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+            while (auto node = worker->steal(lane)) {
+                collect(*node);
+            }
+        }
+    }
+    for (auto& queue : m_injection) {
+        std::lock_guard lock(queue->mutex);
+        for (std::size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+            for (auto* node : queue->jobs[lane]) {
+                collect(node);
+            }
+            queue->jobs[lane].clear();
+            queue->counts[lane].store(0, std::memory_order_relaxed);
+        }
+    }
+    {
+        std::lock_guard lock(m_deadlineMutex);
+        for (auto& heap : m_deadlineJobs) {
+            for (const auto& entry : heap) {
+                collect(entry.node);
+            }
+            heap.clear();
+        }
+        m_deadlineCount.store(0, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard lock(m_ioMutex);
+        for (auto* node : m_ioJobs) {
+            collect(node);
+        }
+        m_ioJobs.clear();
+        m_ioCount.store(0, std::memory_order_relaxed);
+    }
+    {
+        // Sleepers are left suspended; unlinking them lets a later cancellation find nothing filed.
+        std::lock_guard lock(m_timerMutex);
+        auto* timer = m_timerWheel.advance(std::numeric_limits<std::uint64_t>::max());
+        while (timer) {
+            timer = std::exchange(timer->next, nullptr);
+        }
+    }
+    for (auto* node : nodes) {
+        release_node(node);
+    }
+}
+
+bool TaskScheduler::owns_current_thread() const noexcept {
+    return Worker::current(this) != nullptr;
+}
+
+void TaskScheduler::yield_coroutine(std::coroutine_handle<> handle, TaskPriority priority) {
+    auto* node = acquire_node();
+    try {
+        node->job = detail::Job([handle]() mutable {
+            if (handle && !handle.done()) {
+                handle.resume();
+            }
+        }, m_jobStorage);
+    } catch (...) {
+        release_node(node);
+        throw;
+    }
+    push_job(node, priority, detail::kNoDeadline, true);
+}
+
+void TaskScheduler::push_job(detail::JobNode* node, TaskPriority priority, Clock::time_point deadline, bool injected) {
+    if (m_stopped.load(std::memory_order_acquire)) {
+        release_node(node);
+        return;
+    }
+#if SOULLIB_SCHEDULER_METRICS
+    node->enqueuedAt = Clock::now();
+#endif
+    const auto lane = static_cast<std::size_t>(priority);
+    if (deadline != detail::kNoDeadline) {
+        std::lock_guard lock(m_deadlineMutex);
+        auto& heap = m_deadlineJobs[lane];
+        heap.push_back(DeadlineEntry{deadline, node});
+        std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+        m_deadlineCount.fetch_add(1, std::memory_order_release);
+    } else if (auto* worker = injected ? nullptr : Worker::current(this)) {
+        worker->push_local(node, lane);
+    } else {
+        auto& queue = *m_injection[submission_group()];
+        std::lock_guard lock(queue.mutex);
+        queue.jobs[lane].push_back(node);
+        queue.counts[lane].fetch_add(1, std::memory_order_release);
+    }
+    wake_one_worker();
+}
+
+void TaskScheduler::push_batch(const JobBatch& batch, TaskPriority priority) {
+    if (batch.count == 0) {
+        return;
+    }
+    if (m_stopped.load(std::memory_order_acquire)) {
+        for (auto* node = batch.head; node;) {
+            auto* next = std::exchange(node->next, nullptr);
+            release_node(node);
+            node = next;
+        }
+        return;
+    }
+    const auto lane = static_cast<std::size_t>(priority);
+#if SOULLIB_SCHEDULER_METRICS
+    const auto now = Clock::now();
+    for (auto* node = batch.head; node; node = node->next) {
+        node->enqueuedAt = now;
+    }
+#endif
+    if (auto* worker = Worker::current(this)) {
+        // Read `next` before publishing: a thief may run and recycle the node straight away.
+        for (auto* node = batch.head; node;) {
+            auto* next = std::exchange(node->next, nullptr);
+            worker->push_local(node, lane);
+            node = next;
+        }
+    } else {
+        auto& queue = *m_injection[submission_group()];
+        std::lock_guard lock(queue.mutex);
+        for (auto* node = batch.head; node;) {
+            queue.jobs[lane].push_back(node);
+            node = std::exchange(node->next, nullptr);
+        }
+        queue.counts[lane].fetch_add(batch.count, std::memory_order_release);
+    }
+    wake_workers(batch.count);
+}
+
+void TaskScheduler::push_io_job(detail::JobNode* node) {
+    if (m_stopped.load(std::memory_order_acquire)) {
+        release_node(node);
+        return;
+    }
+    {
+        std::lock_guard lock(m_ioMutex);
+        m_ioJobs.push_back(node);
+        m_ioCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_ioCv.notify_one();
+}
+
+void TaskScheduler::run_io_worker(std::size_t index, const CpuSet& cpus) {
+    if (!cpus.empty()) {
+        pin_current_thread(cpus);
+    }
+    Tracer* namedTracer = nullptr;
+    std::unique_lock lock(m_ioMutex);
+    while (true) {
+        m_ioCv.wait(lock, [this]() { return m_ioStopped || !m_ioJobs.empty(); });
+        if (m_ioStopped) {
+            // Like the compute workers, leave queued jobs to the destructor's discard_queued_jobs.
+            return;
+        }
+        auto* node = m_ioJobs.front();
+        m_ioJobs.pop_front();
+        m_ioCount.fetch_sub(1, std::memory_order_relaxed);
+        lock.unlock();
+
+        auto* tracer = active_tracer();
+        Clock::time_point traceStart{};
+        if (tracer) {
+            if (tracer != namedTracer) {
+                tracer->set_thread_name("io worker " + std::to_string(index));
+                namedTracer = tracer;
+            }
+            traceStart = Clock::now();
+        }
+        if (node->job) {
+            node->job();
+        }
+        if (tracer) {
+            tracer->slice("io job", traceStart, Clock::now());
+        }
+        release_node(node);
+        lock.lock();
+    }
+}
+
+SchedulerMetrics TaskScheduler::metrics() const {
+    SchedulerMetrics snapshot;
+    snapshot.enabled = SOULLIB_SCHEDULER_METRICS != 0;
+    for (const auto& queue : m_injection) {
+        for (const auto& count : queue->counts) {
+            snapshot.injectedDepth += count.load(std::memory_order_relaxed);
+        }
+    }
+    snapshot.ioDepth = m_ioCount.load(std::memory_order_relaxed);
+    snapshot.deadlineDepth = m_deadlineCount.load(std::memory_order_relaxed);
+    snapshot.workers.resize(m_workers.size());
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->collect(snapshot.workers[i]);
+    }
+    return snapshot;
+}
+
+void TaskScheduler::set_tracer(std::shared_ptr<Tracer> tracer) {
+    m_tracer.store(tracer.get(), std::memory_order_release);
+    m_tracerOwner = std::move(tracer);
+}
+
+void TaskScheduler::trace_completed(detail::TaskStateBase& state) noexcept {
+    auto& scheduling = *state.scheduling;
+    if (scheduling.traceThread == std::this_thread::get_id() && scheduling.traceSliceOpen) {
+        // Completed inside its first run: record the slice before completion is published, so
+        // it is not lost if whoever waits on the task stops the tracer straight away.
+        scheduling.traceSliceOpen = false;
+        if (auto* tracer = active_tracer()) {
+            tracer->slice(scheduling.traceName, scheduling.traceStart, Clock::now(), scheduling.traceId);
+        }
+    }
+    if (auto* tracer = active_tracer()) {
+        tracer->task_end(scheduling.traceName, scheduling.traceId);
+    }
+}
+
+void TaskScheduler::trace_dependency_released(const detail::ContinuationNode& edge) noexcept {
+    if (auto* tracer = active_tracer()) {
+        const auto& scheduling = *edge.dependent->scheduling;
+        const auto index = static_cast<std::uint64_t>(&edge - scheduling.dependencyEdges.get());
+        tracer->flow_start(scheduling.traceId + 1 + index);
+    }
+}
+
+void TaskScheduler::wake_one_worker() {
+    wake_workers(1);
+}
+
+void TaskScheduler::wake_workers(std::size_t count) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Every polling worker picks a job up on its own; only the rest needs a sleeper.
+    const auto polling = m_spinningWorkers.load(std::memory_order_relaxed);
+    const auto sleeping = m_sleepingWorkers.load(std::memory_order_relaxed);
+    if (count <= polling || sleeping == 0) {
+        return;
+    }
+    const auto wanted = std::min(count - polling, sleeping);
     {
         std::lock_guard lock(m_queueMutex);
-        m_jobs.emplace_back(std::move(job));
     }
-    m_queueCv.notify_one();
+    if (wanted >= sleeping) {
+        m_queueCv.notify_all();
+        return;
+    }
+    for (std::size_t i = 0; i < wanted; ++i) {
+        m_queueCv.notify_one();
+    }
+}
+
+std::size_t TaskScheduler::submission_group() const noexcept {
+    if (m_injection.size() < 2) {
+        return 0;
+    }
+    if (const auto* worker = Worker::current(this)) {
+        return worker->group();
+    }
+    const auto cpu = current_cpu();
+    return cpu && *cpu < m_cpuGroups.size() ? m_cpuGroups[*cpu] : 0;
+}
+
+detail::JobNode* TaskScheduler::take_injected_job(std::size_t lane, std::size_t group) {
+    auto& queue = *m_injection[group];
+    if (queue.counts[lane].load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(queue.mutex);
+    auto& jobs = queue.jobs[lane];
+    if (jobs.empty()) {
+        return nullptr;
+    }
+    auto* node = jobs.front();
+    jobs.pop_front();
+    queue.counts[lane].fetch_sub(1, std::memory_order_relaxed);
+    return node;
+}
+
+detail::JobNode* TaskScheduler::take_remote_injected_job(std::size_t lane, std::size_t group) {
+    for (std::size_t other = 0; other < m_injection.size(); ++other) {
+        if (other == group) {
+            continue;
+        }
+        if (auto* node = take_injected_job(lane, other)) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+detail::JobNode* TaskScheduler::take_deadline_job(std::size_t lane) {
+    if (m_deadlineCount.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    const auto now = Clock::now();
+    std::lock_guard lock(m_deadlineMutex);
+    // Only heaps whose base lane is at or below `lane` can have been promoted into it; within a
+    // heap the earliest deadline is always the most promoted entry.
+    for (std::size_t base = lane; base < kTaskPriorityCount; ++base) {
+        auto& heap = m_deadlineJobs[base];
+        if (heap.empty() ||
+            effective_lane(static_cast<TaskPriority>(base), heap.front().deadline - now) > lane) {
+            continue;
+        }
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+        auto* node = heap.back().node;
+        heap.pop_back();
+        m_deadlineCount.fetch_sub(1, std::memory_order_relaxed);
+        return node;
+    }
+    return nullptr;
+}
+
+detail::JobNode* TaskScheduler::acquire_node() {
+    if (auto* worker = Worker::current(this)) {
+        return worker->acquire_node();
+    }
+    return refill_nodes(1);
+}
+
+void TaskScheduler::release_node(detail::JobNode* node) noexcept {
+    node->job.reset();
+    if (auto* worker = Worker::current(this)) {
+        worker->release_node(node);
+    } else {
+        return_nodes(node, node);
+    }
+}
+
+detail::JobNode* TaskScheduler::refill_nodes(std::size_t count) {
+    std::lock_guard lock(m_nodeMutex);
+
+    detail::JobNode* head = nullptr;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!m_sharedFreeNodes) {
+            auto slab = std::make_unique<detail::JobNode[]>(kNodesPerSlab);
+            for (std::size_t n = 0; n < kNodesPerSlab; ++n) {
+                slab[n].next = m_sharedFreeNodes;
+                m_sharedFreeNodes = &slab[n];
+            }
+            m_nodeSlabs.emplace_back(std::move(slab));
+        }
+        auto* node = m_sharedFreeNodes;
+        m_sharedFreeNodes = node->next;
+        node->next = head;
+        head = node;
+    }
+    return head;
+}
+
+void TaskScheduler::return_nodes(detail::JobNode* head, detail::JobNode* tail) noexcept {
+    std::lock_guard lock(m_nodeMutex);
+    tail->next = m_sharedFreeNodes;
+    m_sharedFreeNodes = head;
+}
+
+bool TaskScheduler::has_visible_jobs() const noexcept {
+    if (m_deadlineCount.load(std::memory_order_acquire) > 0) {
+        return true;
+    }
+    for (const auto& queue : m_injection) {
+        for (const auto& count : queue->counts) {
+            if (count.load(std::memory_order_acquire) > 0) {
+                return true;
+            }
+        }
+    }
+    return std::any_of(m_workers.begin(), m_workers.end(), [](const auto& worker) {
+        return worker->has_jobs();
+    });
 }
 
 void TaskScheduler::schedule_state(const std::shared_ptr<detail::TaskStateBase>& state) {
-    enqueue([state]() {
-        if (state->coroutine && !state->coroutine.done()) {
+    enqueue([this, state]() {
+        start_scheduled(state, false);
+    }, state->priority, state->deadline);
+}
+
+void TaskScheduler::start_scheduled(const std::shared_ptr<detail::TaskStateBase>& state, bool cancellationJob) {
+    Tracer* tracer = nullptr;
+    if (auto* scheduling = state->scheduling.get()) {
+        if (scheduling->claimed.exchange(true, std::memory_order_acq_rel)) {
+            // Only the regular start can lose to a cancellation that already completed the task;
+            // it drops the reference that kept the dependency-blocked task alive.
+            if (!cancellationJob) {
+                state->keepAlive.reset();
+            }
+            return;
+        }
+        scheduling->registration.disarm();
+
+        if (scheduling->traceId && (tracer = active_tracer()) != nullptr) {
+            tracer->task_begin(scheduling->traceName, scheduling->traceId);
+            for (std::size_t i = 0; i < scheduling->dependencyCount; ++i) {
+                if (scheduling->dependencyEdges[i].dependent) {
+                    tracer->flow_end(scheduling->traceId + 1 + i);
+                }
+            }
+        }
+
+        if (scheduling->cancellation.is_cancellation_requested()) {
+            state->exception = std::make_exception_ptr(OperationCancelled{});
+            const auto next = state->on_completed();
+            // A cancellation job may win while dependency edges are still linked; the regular
+            // start releases the keep-alive once they are gone.
+            std::shared_ptr<detail::TaskStateBase> keepAlive;
+            if (!cancellationJob) {
+                keepAlive = std::move(state->keepAlive);
+            }
+            if (next) {
+                next.resume();
+            }
+            return;
+        }
+    }
+
+    if (state->coroutine && !state->coroutine.done()) {
+        if (!tracer) {
             state->coroutine.resume();
+            return;
         }
-    });
+        // The slice covers the run up to the first suspension; task_begin/task_end span the rest.
+        auto& scheduling = *state->scheduling;
+        scheduling.traceThread = std::this_thread::get_id();
+        scheduling.traceStart = Clock::now();
+        scheduling.traceSliceOpen = true;
+        state->coroutine.resume();
+        if (scheduling.traceSliceOpen) {
+            scheduling.traceSliceOpen = false;
+            tracer->slice(scheduling.traceName, scheduling.traceStart, Clock::now(), scheduling.traceId);
+        }
+    }
 }
 
-void TaskScheduler::on_task_finished(const std::shared_ptr<detail::TaskStateBase>& state) {
-    std::vector<std::shared_ptr<detail::TaskStateBase>> ready;
+void TaskScheduler::on_task_cancelled(void* context) noexcept {
+    auto* state = static_cast<detail::TaskStateBase*>(context);
+    // The callback may race with the last handle going away; such a task needs no completing.
+    auto strong = state->weak_from_this().lock();
+    if (!strong) {
+        return;
+    }
+    try {
+        strong->scheduler->enqueue([strong]() {
+            strong->scheduler->start_scheduled(strong, true);
+        }, strong->priority);
+    } catch (...) {
+        // Out of job nodes: the regular start still observes the token and skips the task.
+    }
+}
+
+std::uint64_t TaskScheduler::tick_at(Clock::time_point time) const noexcept {
+    if (time <= m_timerEpoch) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(std::chrono::ceil<TimerTick>(time - m_timerEpoch).count());
+}
+
+bool TaskScheduler::add_timer(detail::TimerNode& node, Clock::time_point wakeTime) {
+    node.dueTick = tick_at(wakeTime);
+    bool wake = false;
     {
-        std::lock_guard lock(state->continuationMutex);
-        for (auto it = state->dependents.begin(); it != state->dependents.end(); ++it) {
-            if (auto dependent = it->lock()) {
-                if (dependent->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-                    ready.emplace_back(std::move(dependent));
+        std::lock_guard lock(m_timerMutex);
+        if (node.cancelled) {
+            return false;
+        }
+        const auto nextEvent = m_timerWheel.next_event_tick();
+        m_timerWheel.insert(&node);
+        if (!m_timerThread.joinable() && !m_timersStopped) {
+            m_timerThread = std::thread([this]() { run_timers(); });
+        } else {
+            // The timer thread only needs waking if this entry is due before its planned wake-up.
+            wake = !nextEvent || node.dueTick < *nextEvent;
+        }
+    }
+    if (wake) {
+        m_timerCv.notify_one();
+    }
+    return true;
+}
+
+void TaskScheduler::cancel_timer(detail::TimerNode& node) noexcept {
+    std::coroutine_handle<> handle{};
+    {
+        std::lock_guard lock(m_timerMutex);
+        if (m_timerWheel.remove(&node)) {
+            handle = node.handle;
+        } else {
+            // Not filed yet (or already expired, in which case the flag is never read again).
+            node.cancelled = true;
+        }
+    }
+    if (!handle) {
+        return;
+    }
+    try {
+        resume_coroutine(handle, node.priority);
+    } catch (...) {
+        // Could not queue the wake-up (and resuming inline would re-enter the cancellation lock):
+        // re-file the node as already due so the timer thread hands it over instead.
+        {
+            std::lock_guard lock(m_timerMutex);
+            node.dueTick = m_timerWheel.current_tick();
+            m_timerWheel.insert(&node);
+        }
+        m_timerCv.notify_one();
+    }
+}
+
+TaskToken TaskScheduler::start_delay(Clock::time_point startTime,
+                                     TaskPriority priority,
+                                     const CancellationToken& cancellation) {
+    auto delay = delay_until(*this, startTime, priority, cancellation);
+    const auto& state = delay.state();
+    state->scheduler = this;
+    state->priority = priority;
+    // Run up to the sleep inline: arming a timer is cheaper than a round trip through the pool.
+    if (state->try_start()) {
+        state->coroutine.resume();
+    }
+    return delay.token();
+}
+
+void TaskScheduler::run_timers() {
+    std::unique_lock lock(m_timerMutex);
+    while (!m_timersStopped) {
+        const auto now = std::chrono::floor<TimerTick>(Clock::now() - m_timerEpoch);
+        auto* expired = m_timerWheel.advance(static_cast<std::uint64_t>(std::max<TimerTick::rep>(0, now.count())));
+        if (expired) {
+            lock.unlock();
+            while (expired) {
+                // The node lives in the sleeping coroutine's frame, which may be gone once resumed.
+                auto* next = expired->next;
+                const auto handle = expired->handle;
+                try {
+                    resume_coroutine(handle, expired->priority);
+                } catch (...) {
+                    // Out of job nodes: resume here rather than strand the sleeper.
+                    if (handle && !handle.done()) {
+                        handle.resume();
+                    }
                 }
+                expired = next;
             }
+            lock.lock();
+            continue;
         }
-        state->dependents.clear();
-    }
 
-    for (auto& dep : ready) {
-        schedule_state(dep);
+        if (const auto nextEvent = m_timerWheel.next_event_tick()) {
+            m_timerCv.wait_until(lock, m_timerEpoch + TimerTick(*nextEvent));
+        } else {
+            m_timerCv.wait(lock);
+        }
     }
 }
 
-void TaskScheduler::resume_coroutine(std::coroutine_handle<> handle) {
+void TaskScheduler::resume_coroutine(std::coroutine_handle<> handle, TaskPriority priority) {
     enqueue([handle]() mutable {
         if (handle && !handle.done()) {
             handle.resume();
         }
-    });
+    }, priority);
 }
 
 } // namespace soul::async
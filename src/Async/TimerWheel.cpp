@@ -0,0 +1,125 @@
+#include "Async/TimerWheel.h"
+
+namespace soul::async::detail {
+
+TimerWheel::TimerWheel(std::uint64_t startTick) noexcept
+    : m_currentTick(startTick) {}
+
+void TimerWheel::insert(TimerNode* node) noexcept {
+    ++m_size;
+    file(node);
+}
+
+bool TimerWheel::remove(TimerNode* node) noexcept {
+    if (!node->link) {
+        return false;
+    }
+    *node->link = node->next;
+    if (node->next) {
+        node->next->link = node->link;
+    }
+    node->next = nullptr;
+    node->link = nullptr;
+    --m_size;
+    return true;
+}
+
+void TimerWheel::push(TimerNode*& head, TimerNode* node) noexcept {
+    node->next = head;
+    node->link = &head;
+    if (head) {
+        head->link = &node->next;
+    }
+    head = node;
+}
+
+void TimerWheel::file(TimerNode* node) noexcept {
+    if (node->dueTick <= m_currentTick) {
+        push(m_expired, node);
+        return;
+    }
+
+    const auto delta = node->dueTick - m_currentTick;
+    std::size_t level = 0;
+    while (level + 1 < kLevels && delta >= (std::uint64_t{1} << shift(level + 1))) {
+        ++level;
+    }
+
+    std::size_t slot = slot_index(node->dueTick, level);
+    if (level == kLevels - 1 && delta >= (std::uint64_t{1} << shift(kLevels))) {
+        // Beyond the wheel's horizon: park in the slot that cascades last and re-file from there.
+        slot = (slot_index(m_currentTick, level) + kSlots - 1) & (kSlots - 1);
+    }
+
+    push(m_slots[level][slot], node);
+}
+
+void TimerWheel::cascade(std::size_t level) noexcept {
+    auto& head = m_slots[level][slot_index(m_currentTick, level)];
+    auto* node = head;
+    head = nullptr;
+    while (node) {
+        auto* next = node->next;
+        file(node);
+        node = next;
+    }
+}
+
+TimerNode* TimerWheel::advance(std::uint64_t tick) noexcept {
+    while (m_currentTick < tick) {
+        // Skip straight past ticks at which no occupied slot becomes current.
+        const auto next = next_slot_tick();
+        if (!next || *next > tick) {
+            m_currentTick = tick;
+            break;
+        }
+        m_currentTick = *next;
+
+        // Higher levels cascade when every level below them wraps to slot zero.
+        for (std::size_t level = 1; level < kLevels; ++level) {
+            if (slot_index(m_currentTick, level - 1) != 0) {
+                break;
+            }
+            cascade(level);
+        }
+        cascade(0);
+    }
+
+    auto* expired = m_expired;
+    m_expired = nullptr;
+    for (auto* node = expired; node; node = node->next) {
+        node->link = nullptr;
+        --m_size;
+    }
+    return expired;
+}
+
+std::optional<std::uint64_t> TimerWheel::next_event_tick() const noexcept {
+    if (m_expired) {
+        return m_currentTick;
+    }
+    return next_slot_tick();
+}
+
+std::optional<std::uint64_t> TimerWheel::next_slot_tick() const noexcept {
+    std::optional<std::uint64_t> earliest;
+    for (std::size_t level = 0; level < kLevels; ++level) {
+        const auto span = std::uint64_t{1} << shift(level);
+        const auto base = (m_currentTick >> shift(level)) << shift(level);
+        const auto current = slot_index(m_currentTick, level);
+        for (std::size_t step = 1; step <= kSlots; ++step) {
+            if (!m_slots[level][(current + step) & (kSlots - 1)]) {
+                continue;
+            }
+            // A slot becomes current when the tick reaches the start of its span on this level.
+            const auto tick = base + step * span;
+            if (!earliest || tick < *earliest) {
+                earliest = tick;
+            }
+            break;
+        }
+    }
+    return earliest;
+}
+
+} // namespace soul::async::detail
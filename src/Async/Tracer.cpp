@@ -0,0 +1,233 @@
+#include "Async/Tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+namespace soul::async {
+
+namespace {
+
+std::atomic_uint64_t g_nextTracerSerial{1};
+
+// Last buffer the thread wrote to; the serial tells tracers apart even if one is freed and
+// another allocated at the same address.
+struct ThreadBufferCache {
+    std::uint64_t serial{0};
+    void* buffer{nullptr};
+};
+
+thread_local ThreadBufferCache t_bufferCache;
+
+double to_microseconds(std::int64_t nanoseconds) noexcept {
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+
+nlohmann::json to_chrome_event(const TraceEvent& event, std::uint32_t threadId) {
+    nlohmann::json json{
+        {"ts", to_microseconds(event.timestamp)},
+        {"pid", 1},
+        {"tid", threadId},
+    };
+    switch (event.type) {
+    case TraceEventType::Slice:
+        json["name"] = event.name;
+        json["ph"] = "X";
+        json["dur"] = to_microseconds(event.duration);
+        json["cat"] = event.id ? "task" : "job";
+        if (event.id) {
+            json["args"] = {{"task", event.id}};
+        }
+        break;
+    case TraceEventType::TaskBegin:
+    case TraceEventType::TaskEnd:
+        json["name"] = event.name;
+        json["ph"] = event.type == TraceEventType::TaskBegin ? "b" : "e";
+        json["cat"] = "task";
+        json["id"] = event.id;
+        break;
+    case TraceEventType::FlowStart:
+    case TraceEventType::FlowEnd:
+        json["name"] = "dependency";
+        json["cat"] = "dependency";
+        json["id"] = event.id;
+        if (event.type == TraceEventType::FlowStart) {
+            json["ph"] = "s";
+        } else {
+            // Bind to the slice enclosing the event, i.e. the dependent task's own slice.
+            json["ph"] = "f";
+            json["bp"] = "e";
+        }
+        break;
+    }
+    return json;
+}
+
+} // namespace
+
+Tracer::Tracer(std::size_t eventsPerThread)
+    : m_serial(g_nextTracerSerial.fetch_add(1, std::memory_order_relaxed)),
+      m_capacity(std::max<std::size_t>(1, eventsPerThread)) {}
+
+Tracer::~Tracer() {
+    stop();
+}
+
+void Tracer::start() noexcept {
+    m_recording.store(true, std::memory_order_seq_cst);
+}
+
+void Tracer::stop() noexcept {
+    m_recording.store(false, std::memory_order_seq_cst);
+    std::lock_guard lock(m_mutex);
+    for (const auto& buffer : m_buffers) {
+        while (buffer->writing.load(std::memory_order_seq_cst)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void Tracer::clear() {
+    stop();
+    std::lock_guard lock(m_mutex);
+    for (const auto& buffer : m_buffers) {
+        buffer->written.store(0, std::memory_order_relaxed);
+    }
+}
+
+const char* Tracer::intern(std::string_view name) {
+    std::lock_guard lock(m_mutex);
+    return m_names.emplace(name).first->c_str();
+}
+
+void Tracer::set_thread_name(std::string_view name) noexcept {
+    auto* buffer = buffer_for_current_thread();
+    if (!buffer) {
+        return;
+    }
+    try {
+        std::lock_guard lock(m_mutex);
+        buffer->name.assign(name);
+    } catch (...) {
+        // The track keeps its numeric label.
+    }
+}
+
+void Tracer::slice(const char* name, Clock::time_point start, Clock::time_point end, std::uint64_t id) noexcept {
+    record(TraceEvent{name, since_epoch(start), since_epoch(end) - since_epoch(start), id, TraceEventType::Slice});
+}
+
+void Tracer::task_begin(const char* name, std::uint64_t id) noexcept {
+    record(TraceEvent{name, since_epoch(Clock::now()), 0, id, TraceEventType::TaskBegin});
+}
+
+void Tracer::task_end(const char* name, std::uint64_t id) noexcept {
+    record(TraceEvent{name, since_epoch(Clock::now()), 0, id, TraceEventType::TaskEnd});
+}
+
+void Tracer::flow_start(std::uint64_t id) noexcept {
+    record(TraceEvent{nullptr, since_epoch(Clock::now()), 0, id, TraceEventType::FlowStart});
+}
+
+void Tracer::flow_end(std::uint64_t id) noexcept {
+    record(TraceEvent{nullptr, since_epoch(Clock::now()), 0, id, TraceEventType::FlowEnd});
+}
+
+std::vector<ThreadTrace> Tracer::collect() {
+    stop();
+    std::lock_guard lock(m_mutex);
+    std::vector<ThreadTrace> traces;
+    traces.reserve(m_buffers.size());
+    for (const auto& buffer : m_buffers) {
+        const auto written = buffer->written.load(std::memory_order_acquire);
+        const auto kept = std::min<std::uint64_t>(written, m_capacity);
+        ThreadTrace trace;
+        trace.threadId = buffer->threadId;
+        trace.name = buffer->name;
+        trace.dropped = written - kept;
+        trace.events.reserve(static_cast<std::size_t>(kept));
+        for (auto index = written - kept; index < written; ++index) {
+            trace.events.push_back(buffer->events[static_cast<std::size_t>(index % m_capacity)]);
+        }
+        traces.push_back(std::move(trace));
+    }
+    return traces;
+}
+
+void Tracer::write_chrome_trace(std::ostream& out) {
+    const auto traces = collect();
+
+    bool first = true;
+    const auto emit = [&](const nlohmann::json& event) {
+        out << (first ? "\n" : ",\n") << event.dump();
+        first = false;
+    };
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    emit({{"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"args", {{"name", "SoulLib"}}}});
+    for (const auto& trace : traces) {
+        const auto name = trace.name.empty() ? "thread " + std::to_string(trace.threadId) : trace.name;
+        emit({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", trace.threadId}, {"args", {{"name", name}}}});
+    }
+    for (const auto& trace : traces) {
+        for (const auto& event : trace.events) {
+            emit(to_chrome_event(event, trace.threadId));
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Tracer::write_chrome_trace_file(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open trace file: " + path);
+    }
+    write_chrome_trace(file);
+}
+
+void Tracer::record(TraceEvent event) noexcept {
+    auto* buffer = buffer_for_current_thread();
+    if (!buffer) {
+        return;
+    }
+    // Pairs with `stop`: either it sees this flag raised and waits, or this load sees the
+    // recording flag cleared and nothing is written.
+    buffer->writing.store(true, std::memory_order_seq_cst);
+    if (m_recording.load(std::memory_order_seq_cst)) {
+        const auto index = buffer->written.load(std::memory_order_relaxed);
+        buffer->events[static_cast<std::size_t>(index % m_capacity)] = event;
+        buffer->written.store(index + 1, std::memory_order_release);
+    }
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+Tracer::ThreadBuffer* Tracer::buffer_for_current_thread() noexcept {
+    if (t_bufferCache.serial == m_serial) {
+        return static_cast<ThreadBuffer*>(t_bufferCache.buffer);
+    }
+
+    try {
+        std::lock_guard lock(m_mutex);
+        const auto self = std::this_thread::get_id();
+        const auto it = std::find_if(m_buffers.begin(), m_buffers.end(), [&](const auto& buffer) {
+            return buffer->owner == self;
+        });
+        ThreadBuffer* buffer = nullptr;
+        if (it != m_buffers.end()) {
+            buffer = it->get();
+        } else {
+            const auto threadId = static_cast<std::uint32_t>(m_buffers.size() + 1);
+            buffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>(self, threadId, m_capacity)).get();
+        }
+        t_bufferCache = ThreadBufferCache{m_serial, buffer};
+        return buffer;
+    } catch (...) {
+        // Out of memory: this thread's events are dropped.
+        return nullptr;
+    }
+}
+
+} // namespace soul::async
@@ -1,5 +1,7 @@
 #include "FileSystem/Core/AsyncFileManager.h"
 
+#include "Async/WhenAll.h"
+
 #include <cstring>
 #include <string_view>
 #include <system_error>
@@ -18,8 +20,9 @@ AsyncFileManager::AsyncFileManager(std::shared_ptr<io::IAsyncFileIO> ioBackend,
     }
 }
 
-soul::async::Task<io::ReadFileResult> AsyncFileManager::read(std::filesystem::path path) {
-    auto result = co_await m_io->read(std::move(path));
+soul::async::Task<io::ReadFileResult> AsyncFileManager::read(std::filesystem::path path,
+                                                            soul::async::CancellationToken cancellation) {
+    auto result = co_await m_io->read(std::move(path), std::move(cancellation));
     if (result.error) {
         co_return result;
     }
@@ -33,8 +36,21 @@ soul::async::Task<io::ReadFileResult> AsyncFileManager::read(std::filesystem::pa
     co_return result;
 }
 
+soul::async::Task<std::vector<io::ReadFileResult>> AsyncFileManager::read_all(
+    std::vector<std::filesystem::path> paths,
+    soul::async::CancellationToken cancellation) {
+    std::vector<soul::async::Task<io::ReadFileResult>> reads;
+    reads.reserve(paths.size());
+    for (auto& path : paths) {
+        reads.push_back(read(std::move(path), cancellation));
+    }
+    auto join = soul::async::when_all(std::move(reads));
+    co_return co_await join;
+}
+
 soul::async::Task<io::WriteFileResult> AsyncFileManager::write(std::filesystem::path path,
-                                                               std::span<const std::byte> data) {
+                                                               std::span<const std::byte> data,
+                                                               soul::async::CancellationToken cancellation) {
     std::vector<uint8_t> plain(data.size());
     if (!data.empty()) {
         std::memcpy(plain.data(), data.data(), data.size());
@@ -42,7 +58,7 @@ soul::async::Task<io::WriteFileResult> AsyncFileManager::write(std::filesystem::
     auto encrypted = m_encryption->encrypt(plain);
     std::vector<std::byte> buffer(encrypted.size());
     std::memcpy(buffer.data(), encrypted.data(), encrypted.size());
-    auto writeResult = co_await m_io->write(std::move(path), buffer);
+    auto writeResult = co_await m_io->write(std::move(path), buffer, std::move(cancellation));
     co_return writeResult;
 }
 
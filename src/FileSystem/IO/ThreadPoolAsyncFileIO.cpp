@@ -7,14 +7,28 @@
 
 namespace soul::filesystem::io {
 
+namespace {
+
+std::error_code cancelled_error() {
+    return std::make_error_code(std::errc::operation_canceled);
+}
+
+} // namespace
+
 ThreadPoolAsyncFileIO::ThreadPoolAsyncFileIO(std::shared_ptr<soul::async::TaskScheduler> scheduler)
     : m_scheduler(std::move(scheduler)) {
 }
 
-soul::async::Task<ReadFileResult> ThreadPoolAsyncFileIO::read(std::filesystem::path path) {
+soul::async::Task<ReadFileResult> ThreadPoolAsyncFileIO::read(std::filesystem::path path,
+                                                              soul::async::CancellationToken cancellation) {
     auto scheduler = m_scheduler;
-    co_return co_await scheduler->run_async([path = std::move(path)]() -> ReadFileResult {
+    // Build the job outside the co_await expression: GCC 12 mis-handles closure temporaries
+    // that live across a suspension point and destroys their captures twice.
+    auto task = scheduler->run_io([path = std::move(path), cancellation = std::move(cancellation)]() -> ReadFileResult {
 #if SOULLIB_HAS_EXPECTED
+        if (cancellation.is_cancellation_requested()) {
+            return std::unexpected(cancelled_error());
+        }
         auto canonicalPath = std::filesystem::absolute(path);
         std::ifstream file(canonicalPath, std::ios::binary);
         if (!file) {
@@ -39,6 +53,10 @@ soul::async::Task<ReadFileResult> ThreadPoolAsyncFileIO::read(std::filesystem::p
 #else
         ReadFileResult result;
         result.path = std::filesystem::absolute(path);
+        if (cancellation.is_cancellation_requested()) {
+            result.error = cancelled_error();
+            return result;
+        }
 
         std::ifstream file(result.path, std::ios::binary);
         if (!file) {
@@ -63,14 +81,20 @@ soul::async::Task<ReadFileResult> ThreadPoolAsyncFileIO::read(std::filesystem::p
         return result;
 #endif
     });
+    co_return co_await task;
 }
 
 soul::async::Task<WriteFileResult> ThreadPoolAsyncFileIO::write(std::filesystem::path path,
-                                                                std::span<const std::byte> data) {
+                                                                std::span<const std::byte> data,
+                                                                soul::async::CancellationToken cancellation) {
     auto scheduler = m_scheduler;
     std::vector<std::byte> buffer(data.begin(), data.end());
-    co_return co_await scheduler->run_async([path = std::move(path), buffer = std::move(buffer)]() mutable {
+    auto task = scheduler->run_io([path = std::move(path), buffer = std::move(buffer),
+                                   cancellation = std::move(cancellation)]() mutable -> WriteFileResult {
 #if SOULLIB_HAS_EXPECTED
+        if (cancellation.is_cancellation_requested()) {
+            return std::unexpected(cancelled_error());
+        }
         auto canonicalPath = std::filesystem::absolute(path);
         std::ofstream file(canonicalPath, std::ios::binary | std::ios::trunc);
         if (!file) {
@@ -89,6 +113,10 @@ soul::async::Task<WriteFileResult> ThreadPoolAsyncFileIO::write(std::filesystem:
 #else
         WriteFileResult result;
         result.path = std::filesystem::absolute(path);
+        if (cancellation.is_cancellation_requested()) {
+            result.error = cancelled_error();
+            return result;
+        }
 
         std::ofstream file(result.path, std::ios::binary | std::ios::trunc);
         if (!file) {
@@ -107,6 +135,7 @@ soul::async::Task<WriteFileResult> ThreadPoolAsyncFileIO::write(std::filesystem:
         return result;
 #endif
     });
+    co_return co_await task;
 }
 
 } // namespace soul::filesystem::io
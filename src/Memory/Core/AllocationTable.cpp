@@ -0,0 +1,104 @@
+#include "Memory/Core/AllocationTable.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace Memory::Core {
+
+namespace {
+constexpr int kInitialBits = 4;
+} // namespace
+
+size_t AllocationTable::home(const void* ptr) const noexcept {
+    // Mixes the whole address: MemoryManager already used its top bits to pick the shard.
+    auto key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr));
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return static_cast<size_t>(key >> (64 - bits_));
+}
+
+bool AllocationTable::insert(void* ptr, const AllocationInfo& info, AllocationInfo& replaced) {
+    // Kept at most three quarters full so probe runs stay short.
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+        grow();
+    }
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = home(ptr);; index = (index + 1) & mask) {
+        auto& slot = slots_[index];
+        if (!slot.ptr) {
+            slot.ptr = ptr;
+            slot.info = info;
+            ++size_;
+            return false;
+        }
+        if (slot.ptr == ptr) {
+            replaced = std::exchange(slot.info, info);
+            return true;
+        }
+    }
+}
+
+bool AllocationTable::erase(void* ptr, AllocationInfo& removed) {
+    if (size_ == 0) {
+        return false;
+    }
+    const size_t mask = slots_.size() - 1;
+    size_t hole = home(ptr);
+    while (slots_[hole].ptr != ptr) {
+        if (!slots_[hole].ptr) {
+            return false;
+        }
+        hole = (hole + 1) & mask;
+    }
+    removed = slots_[hole].info;
+    --size_;
+
+    // Shift later members of the probe run back so lookups never need tombstones.
+    for (size_t next = (hole + 1) & mask; slots_[next].ptr; next = (next + 1) & mask) {
+        const size_t wanted = home(slots_[next].ptr);
+        const bool reachable = hole <= next ? (wanted <= hole || wanted > next)
+                                            : (wanted <= hole && wanted > next);
+        if (reachable) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+    }
+    slots_[hole] = Slot{};
+    return true;
+}
+
+const AllocationInfo* AllocationTable::find(void* ptr) const noexcept {
+    if (size_ == 0) {
+        return nullptr;
+    }
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = home(ptr); slots_[index].ptr; index = (index + 1) & mask) {
+        if (slots_[index].ptr == ptr) {
+            return &slots_[index].info;
+        }
+    }
+    return nullptr;
+}
+
+void AllocationTable::clear() noexcept {
+    for (auto& slot : slots_) {
+        slot = Slot{};
+    }
+    size_ = 0;
+}
+
+void AllocationTable::grow() {
+    std::vector<Slot> previous(std::exchange(slots_, {}));
+    bits_ = previous.empty() ? kInitialBits : bits_ + 1;
+    slots_.resize(size_t{1} << bits_);
+    size_ = 0;
+    AllocationInfo unused{};
+    for (const auto& slot : previous) {
+        if (slot.ptr) {
+            insert(slot.ptr, slot.info, unused);
+        }
+    }
+}
+
+} // namespace Memory::Core
@@ -1,6 +1,7 @@
+#include <bit>
+#include <cstdint>
 #include <sstream>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include "debug/Debug.h"
 #include "Memory/Core/MemoryManager.h"
@@ -8,12 +9,24 @@
 namespace Memory::Core {
 
 void MemoryManager::setDebugMode(bool enabled) {
-    debugMode_ = enabled;
+    debugMode_.store(enabled, std::memory_order_relaxed);
 }
 
 void MemoryManager::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    allocations_.clear();
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.allocations.clear();
+    }
+    counters_.reset();
+}
+
+size_t MemoryManager::shardIndex(const void* ptr) noexcept {
+    static_assert(std::has_single_bit(kShardCount), "shard count must be a power of two");
+    constexpr int kShardBits = std::countr_zero(kShardCount);
+    // Fibonacci hashing of the address without its alignment bits, so neighbouring blocks from
+    // one thread land in different shards.
+    const auto address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) >> 4;
+    return static_cast<size_t>((address * 0x9E3779B97F4A7C15ull) >> (64 - kShardBits));
 }
 
 namespace {
@@ -32,9 +45,18 @@ std::string formatTag(const MemoryTag& tag) {
 } // namespace
 
 void MemoryManager::registerAllocation(void* ptr, size_t size, MemoryTag tag) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    allocations_[ptr] = {size, tag};
-    if (debugMode_) {
+    AllocationInfo replaced{};
+    bool wasTracked = false;
+    {
+        auto& shard = shardFor(ptr);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        wasTracked = shard.allocations.insert(ptr, {size, tag}, replaced);
+    }
+    counters_.add(tag, size);
+    if (wasTracked) {
+        counters_.remove(replaced.tag, replaced.size);
+    }
+    if (getDebugMode()) {
         std::stringstream ss;
         ss << "Allocated " << size << " bytes at " << ptr << " [" << formatTag(tag) << "]";
         Debug::Debug(ss.str(), {__FILE__, __LINE__, __FUNCTION__});
@@ -42,80 +64,54 @@ void MemoryManager::registerAllocation(void* ptr, size_t size, MemoryTag tag) {
 }
 
 void MemoryManager::unregisterAllocation(void* ptr) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = allocations_.find(ptr);
-    if (it != allocations_.end()) {
-        if (debugMode_) {
-            std::stringstream ss;
-            ss << "Deallocated " << it->second.size << " bytes at " << ptr << " [" << formatTag(it->second.tag) << "]";
-            Debug::Debug(ss.str(), {__FILE__, __LINE__, __FUNCTION__});
+    AllocationInfo info{};
+    {
+        auto& shard = shardFor(ptr);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.allocations.erase(ptr, info)) {
+            return;
         }
-        allocations_.erase(it);
+    }
+    counters_.remove(info.tag, info.size);
+    if (getDebugMode()) {
+        std::stringstream ss;
+        ss << "Deallocated " << info.size << " bytes at " << ptr << " [" << formatTag(info.tag) << "]";
+        Debug::Debug(ss.str(), {__FILE__, __LINE__, __FUNCTION__});
     }
 }
 
 void MemoryManager::reportLeaks() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto& entry : allocations_) {
-        const auto& ptr = entry.first;
-        const auto& info = entry.second;
-        std::stringstream ss;
-        ss << "Leaked " << info.size << " bytes at " << ptr << " [" << formatTag(info.tag) << "]";
-        Debug::Debug(ss.str(), {__FILE__, __LINE__, __FUNCTION__});
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.allocations.forEach([](const void* ptr, const AllocationInfo& info) {
+            std::stringstream ss;
+            ss << "Leaked " << info.size << " bytes at " << ptr << " [" << formatTag(info.tag) << "]";
+            Debug::Debug(ss.str(), {__FILE__, __LINE__, __FUNCTION__});
+        });
     }
 }
 
 size_t MemoryManager::getTotalAllocated() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    size_t total = 0;
-    for (const auto& [_, info] : allocations_) total += info.size;
-    return total;
+    return counters_.totalBytes();
 }
 
 size_t MemoryManager::getAllocationCount() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return allocations_.size();
+    return counters_.allocationCount();
 }
 
 size_t MemoryManager::getAllocationSize(void* ptr) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = allocations_.find(ptr);
-    return (it != allocations_.end()) ? it->second.size : 0;
+    auto& shard = shardFor(ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto* info = shard.allocations.find(ptr);
+    return info ? info->size : 0;
 }
 
 size_t MemoryManager::getAllocatedByTag(MemoryTag tag) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    size_t sum = 0;
-    for (const auto& entry : allocations_) {
-        if (entry.second.tag == tag) {
-            sum += entry.second.size;
-        }
-    }
-    return sum;
+    return counters_.bytesForTag(tag);
 }
 
 MemoryStatistics MemoryManager::snapshot() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    MemoryStatistics stats;
-    stats.totalBytes = 0;
-    stats.allocationCount = allocations_.size();
-
-    std::unordered_map<uint32_t, MemoryTagStats> perTag;
-    perTag.reserve(allocations_.size());
-
-    for (const auto& [pointer, info] : allocations_) {
-        stats.totalBytes += info.size;
-        auto& bucket = perTag[info.tag.hash];
-        bucket.tag = info.tag;
-        bucket.bytes += info.size;
-        bucket.allocations += 1;
-    }
-
-    stats.tags.reserve(perTag.size());
-    for (auto& [_, tagStats] : perTag) {
-        stats.tags.emplace_back(std::move(tagStats));
-    }
-    return stats;
+    return counters_.statistics();
 }
 
 } // namespace Memory::Core
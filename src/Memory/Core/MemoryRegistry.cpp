@@ -1,5 +1,6 @@
 #include "Memory/Core/MemoryRegistry.h"
 #include "Memory/Core/MemoryManager.h"
+#include "Memory/Core/StatisticsMemoryManager.h"
 
 namespace Memory::Core {
 namespace {
@@ -11,7 +12,11 @@ std::atomic<IMemoryManager*>& MemoryRegistry::storage() {
 }
 
 IMemoryManager& MemoryRegistry::defaultManager() {
+#if SOULLIB_MEMORY_STATISTICS_ONLY
+    static StatisticsMemoryManager manager;
+#else
     static MemoryManager manager;
+#endif
     return manager;
 }
 
@@ -0,0 +1,67 @@
+#include <sstream>
+#include <string>
+#include "debug/Debug.h"
+#include "Memory/Core/StatisticsMemoryManager.h"
+#include "Memory/Core/ThreadCache.h"
+
+namespace Memory::Core {
+
+void StatisticsMemoryManager::clear() noexcept {
+    ThreadCache::flushAccounting();
+    counters_.reset();
+}
+
+void StatisticsMemoryManager::registerAllocation(void*, size_t size, MemoryTag tag) {
+    counters_.add(tag, size);
+}
+
+void StatisticsMemoryManager::unregisterAllocation(void*) {
+}
+
+void StatisticsMemoryManager::unregisterAllocation(void*, size_t size, MemoryTag tag) {
+    counters_.remove(tag, size);
+}
+
+void StatisticsMemoryManager::reportLeaks() {
+    ThreadCache::flushAccounting();
+    for (const auto& tag : counters_.statistics().tags) {
+        std::stringstream ss;
+        ss << "Leaked " << tag.bytes << " bytes in " << tag.allocations << " allocations [";
+#ifdef SOUL_DEBUG
+        if (!tag.tag.label.empty()) {
+            ss << tag.tag.label;
+        } else
+#endif
+        {
+            ss << tag.tag.hash;
+        }
+        ss << "]";
+        Debug::Debug(ss.str(), {__FILE__, __LINE__, __FUNCTION__});
+    }
+}
+
+size_t StatisticsMemoryManager::getTotalAllocated() {
+    ThreadCache::flushAccounting();
+    return counters_.totalBytes();
+}
+
+size_t StatisticsMemoryManager::getAllocationCount() {
+    ThreadCache::flushAccounting();
+    return counters_.allocationCount();
+}
+
+size_t StatisticsMemoryManager::getAllocationSize(void*) {
+    return 0;
+}
+
+size_t StatisticsMemoryManager::getAllocatedByTag(MemoryTag tag) {
+    ThreadCache::flushAccounting();
+    return counters_.bytesForTag(tag);
+}
+
+MemoryStatistics StatisticsMemoryManager::snapshot() {
+    ThreadCache::flushAccounting();
+    return counters_.statistics();
+}
+
+} // namespace Memory::Core
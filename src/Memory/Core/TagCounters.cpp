@@ -0,0 +1,198 @@
+#include "Memory/Core/TagCounters.h"
+
+#include <shared_mutex>
+#include <thread>
+
+namespace Memory::Core {
+
+namespace {
+constexpr std::uint64_t kReady = std::uint64_t{1} << 32;
+constexpr std::uint64_t kClaiming = std::uint64_t{1} << 33;
+
+size_t clampToZero(std::int64_t value) noexcept {
+    return value > 0 ? static_cast<size_t>(value) : 0;
+}
+
+// Every TagCounters alive, with its generation. Never destroyed, so batches flushed by exiting
+// threads after static destruction has begun still find it.
+struct LiveCounters {
+    std::shared_mutex mutex;
+    std::unordered_map<const TagCounters*, std::uint64_t> generations;
+    std::uint64_t nextGeneration {1};
+};
+
+LiveCounters& liveCounters() {
+    static auto* live = new LiveCounters;
+    return *live;
+}
+} // namespace
+
+TagCounters::TagCounters() {
+    auto& live = liveCounters();
+    std::unique_lock lock(live.mutex);
+    generation_ = live.nextGeneration++;
+    live.generations[this] = generation_;
+}
+
+TagCounters::~TagCounters() {
+    auto& live = liveCounters();
+    std::unique_lock lock(live.mutex);
+    live.generations.erase(this);
+}
+
+void TagCounters::updateIfLive(TagCounters* counters, std::uint64_t generation,
+                               MemoryTag tag, std::int64_t bytes, std::int64_t allocations) noexcept {
+    auto& live = liveCounters();
+    // Held while updating so the owner cannot be destroyed halfway through.
+    std::shared_lock lock(live.mutex);
+    const auto it = live.generations.find(counters);
+    if (it != live.generations.end() && it->second == generation) {
+        counters->update(tag, bytes, allocations);
+    }
+}
+
+size_t TagCounters::currentStripe() noexcept {
+    static std::atomic<size_t> nextStripe {0};
+    thread_local const size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % kStripeCount;
+    return stripe;
+}
+
+TagCounters::TagSlot* TagCounters::slotFor(Stripe& stripe, MemoryTag tag) noexcept {
+    const std::uint64_t wanted = kReady | tag.hash;
+    const size_t mask = kTagSlots - 1;
+    for (size_t probe = 0, index = probeStart(tag); probe < kTagSlots; ++probe, index = (index + 1) & mask) {
+        auto& slot = stripe.tags[index];
+        auto key = slot.key.load(std::memory_order_acquire);
+        if (key == 0) {
+            if (slot.key.compare_exchange_strong(key, kClaiming, std::memory_order_acquire)) {
+                slot.tag = tag;
+                slot.key.store(wanted, std::memory_order_release);
+                return &slot;
+            }
+        }
+        // Another thread sharing the stripe is publishing this slot's tag; it takes a few stores.
+        while (key == kClaiming) {
+            std::this_thread::yield();
+            key = slot.key.load(std::memory_order_acquire);
+        }
+        if (key == wanted) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+void TagCounters::update(MemoryTag tag, std::int64_t bytes, std::int64_t allocations) noexcept {
+    if (auto* slot = slotFor(stripes_[currentStripe()], tag)) {
+        slot->bytes.fetch_add(bytes, std::memory_order_relaxed);
+        slot->allocations.fetch_add(allocations, std::memory_order_relaxed);
+        return;
+    }
+    try {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        overflowUsed_.store(true, std::memory_order_relaxed);
+        auto& entry = overflow_[tag.hash];
+        entry.tag = tag;
+        entry.bytes += bytes;
+        entry.allocations += allocations;
+    } catch (...) {
+        // Out of memory while recording a tag past the slot limit: only its per-tag figure is lost.
+    }
+}
+
+TagCounters::Totals TagCounters::totals() const noexcept {
+    std::int64_t bytes = 0;
+    std::int64_t allocations = 0;
+    for (const auto& stripe : stripes_) {
+        for (const auto& slot : stripe.tags) {
+            bytes += slot.bytes.load(std::memory_order_relaxed);
+            allocations += slot.allocations.load(std::memory_order_relaxed);
+        }
+    }
+    if (overflowUsed_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        for (const auto& [_, entry] : overflow_) {
+            bytes += entry.bytes;
+            allocations += entry.allocations;
+        }
+    }
+    return {clampToZero(bytes), clampToZero(allocations)};
+}
+
+size_t TagCounters::bytesForTag(MemoryTag tag) const noexcept {
+    const std::uint64_t wanted = kReady | tag.hash;
+    const size_t mask = kTagSlots - 1;
+    std::int64_t total = 0;
+    bool full = false;
+    for (const auto& stripe : stripes_) {
+        size_t probe = 0;
+        for (size_t index = probeStart(tag); probe < kTagSlots; ++probe, index = (index + 1) & mask) {
+            const auto key = stripe.tags[index].key.load(std::memory_order_acquire);
+            if (key == wanted) {
+                total += stripe.tags[index].bytes.load(std::memory_order_relaxed);
+                break;
+            }
+            if (key == 0) {
+                break;
+            }
+        }
+        full = full || probe == kTagSlots;
+    }
+    if (full) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        if (const auto it = overflow_.find(tag.hash); it != overflow_.end()) {
+            total += it->second.bytes;
+        }
+    }
+    return clampToZero(total);
+}
+
+MemoryStatistics TagCounters::statistics() const {
+    const auto sums = totals();
+    MemoryStatistics stats;
+    stats.totalBytes = sums.bytes;
+    stats.allocationCount = sums.allocations;
+
+    std::unordered_map<std::uint32_t, OverflowEntry> perTag;
+    for (const auto& stripe : stripes_) {
+        for (const auto& slot : stripe.tags) {
+            if ((slot.key.load(std::memory_order_acquire) & kReady) == 0) {
+                continue;
+            }
+            auto& entry = perTag[slot.tag.hash];
+            entry.tag = slot.tag;
+            entry.bytes += slot.bytes.load(std::memory_order_relaxed);
+            entry.allocations += slot.allocations.load(std::memory_order_relaxed);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        for (const auto& [hash, overflow] : overflow_) {
+            auto& entry = perTag[hash];
+            entry.tag = overflow.tag;
+            entry.bytes += overflow.bytes;
+            entry.allocations += overflow.allocations;
+        }
+    }
+
+    for (const auto& [_, entry] : perTag) {
+        if (entry.allocations > 0) {
+            stats.tags.push_back({entry.tag, clampToZero(entry.bytes), clampToZero(entry.allocations)});
+        }
+    }
+    return stats;
+}
+
+void TagCounters::reset() noexcept {
+    for (auto& stripe : stripes_) {
+        for (auto& slot : stripe.tags) {
+            slot.bytes.store(0, std::memory_order_relaxed);
+            slot.allocations.store(0, std::memory_order_relaxed);
+        }
+    }
+    std::lock_guard<std::mutex> lock(overflowMutex_);
+    overflow_.clear();
+    overflowUsed_.store(false, std::memory_order_relaxed);
+}
+
+} // namespace Memory::Core
@@ -0,0 +1,267 @@
+#include "Memory/Core/ThreadCache.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include "Memory/Core/TagCounters.h"
+
+namespace Memory::Core {
+
+namespace {
+constexpr size_t kPendingSlots = 8;
+
+constexpr size_t sizeClass(size_t bytes) noexcept {
+    return bytes == 0 ? 0 : (bytes - 1) / ThreadCache::kAlignment;
+}
+
+constexpr size_t classBytes(size_t sizeClass) noexcept {
+    return (sizeClass + 1) * ThreadCache::kAlignment;
+}
+
+// Blocks moved between a thread and the central lists at once: about 4 KiB, between 8 and 64.
+constexpr size_t batchSize(size_t sizeClass) noexcept {
+    return std::clamp<size_t>(4096 / classBytes(sizeClass), 8, 64);
+}
+
+void*& nextOf(void* block) noexcept {
+    return *static_cast<void**>(block);
+}
+
+struct alignas(64) CentralList {
+    std::mutex mutex;
+    void* head {nullptr};
+    char* carve {nullptr};
+    char* carveEnd {nullptr};
+};
+
+// Shared by all threads and never destroyed: blocks stay valid for the life of the process and
+// threads exiting during static destruction can still hand theirs back.
+std::array<CentralList, ThreadCache::kSizeClassCount>& centralLists() {
+    static auto* lists = new std::array<CentralList, ThreadCache::kSizeClassCount>;
+    return *lists;
+}
+
+// Takes up to `count` blocks as a chain, carving fresh ones when the list runs dry.
+void* fetchBatch(size_t sizeClass, size_t count) {
+    auto& central = centralLists()[sizeClass];
+    const size_t bytes = classBytes(sizeClass);
+    std::lock_guard<std::mutex> lock(central.mutex);
+    void* head = nullptr;
+    for (size_t taken = 0; taken < count; ++taken) {
+        void* block = central.head;
+        if (block) {
+            central.head = nextOf(block);
+        } else {
+            if (central.carve == central.carveEnd) {
+                if (taken > 0) {
+                    break;
+                }
+                central.carve = static_cast<char*>(::operator new(ThreadCache::kChunkSize));
+                central.carveEnd = central.carve + ThreadCache::kChunkSize / bytes * bytes;
+            }
+            block = central.carve;
+            central.carve += bytes;
+        }
+        nextOf(block) = head;
+        head = block;
+    }
+    return head;
+}
+
+void releaseChain(size_t sizeClass, void* head, void* tail) noexcept {
+    auto& central = centralLists()[sizeClass];
+    std::lock_guard<std::mutex> lock(central.mutex);
+    nextOf(tail) = central.head;
+    central.head = head;
+}
+
+struct FreeList {
+    void* head {nullptr};
+    size_t length {0};
+};
+
+struct PendingTag {
+    TagCounters* counters {nullptr};
+    std::uint64_t generation {0};
+    MemoryTag tag {};
+    std::int64_t bytes {0};
+    std::int64_t allocations {0};
+};
+
+enum class CacheState : unsigned char { Fresh, Live, Dead };
+
+// Trivially destructible so it stays usable, through the central lists, after the thread's
+// CacheReaper has run.
+struct LocalCache {
+    CacheState state {CacheState::Fresh};
+    unsigned pendingOps {0};
+    std::array<FreeList, ThreadCache::kSizeClassCount> lists {};
+    std::array<PendingTag, kPendingSlots> pending {};
+};
+
+thread_local LocalCache t_cache;
+
+struct CacheReaper {
+    void arm() noexcept {}
+    ~CacheReaper() {
+        ThreadCache::releaseCachedBlocks();
+        ThreadCache::flushAccounting();
+        t_cache.state = CacheState::Dead;
+    }
+};
+
+thread_local CacheReaper t_reaper;
+
+bool isLive(LocalCache& cache) noexcept {
+    if (cache.state == CacheState::Live) [[likely]] {
+        return true;
+    }
+    if (cache.state == CacheState::Dead) {
+        return false;
+    }
+    t_reaper.arm();
+    cache.state = CacheState::Live;
+    return true;
+}
+
+void flushPending(LocalCache& cache) noexcept {
+    for (auto& slot : cache.pending) {
+        if (slot.counters && (slot.bytes != 0 || slot.allocations != 0)) {
+            TagCounters::updateIfLive(slot.counters, slot.generation, slot.tag, slot.bytes, slot.allocations);
+        }
+        slot = PendingTag{};
+    }
+    cache.pendingOps = 0;
+}
+
+// Adds to the thread's pending change for (counters, tag); false once the thread is exiting.
+bool accumulate(TagCounters& counters, MemoryTag tag, std::int64_t bytes, std::int64_t allocations) noexcept {
+    auto& cache = t_cache;
+    if (!isLive(cache)) {
+        return false;
+    }
+    PendingTag* target = nullptr;
+    for (auto& slot : cache.pending) {
+        if (slot.counters == &counters && slot.tag == tag) {
+            target = &slot;
+            break;
+        }
+        if (!slot.counters) {
+            target = &slot;
+            target->counters = &counters;
+            target->generation = counters.generation();
+            target->tag = tag;
+            break;
+        }
+    }
+    if (!target) {
+        flushPending(cache);
+        target = &cache.pending[0];
+        *target = {&counters, counters.generation(), tag, 0, 0};
+    }
+    target->bytes += bytes;
+    target->allocations += allocations;
+    if (++cache.pendingOps >= ThreadCache::kAccountingBatch) {
+        flushPending(cache);
+    }
+    return true;
+}
+
+// Hands `count` blocks from the front of `list` back to the central lists.
+void drain(FreeList& list, size_t sizeClass, size_t count) noexcept {
+    void* head = list.head;
+    void* tail = head;
+    for (size_t i = 1; i < count; ++i) {
+        tail = nextOf(tail);
+    }
+    list.head = nextOf(tail);
+    list.length -= count;
+    releaseChain(sizeClass, head, tail);
+}
+} // namespace
+
+void* ThreadCache::allocate(size_t bytes) {
+    if (bytes > kMaxSmallSize) {
+        return ::operator new(bytes);
+    }
+    const size_t cls = sizeClass(bytes);
+    auto& cache = t_cache;
+    if (!isLive(cache)) [[unlikely]] {
+        return fetchBatch(cls, 1);
+    }
+    auto& list = cache.lists[cls];
+    if (!list.head) [[unlikely]] {
+        list.head = fetchBatch(cls, batchSize(cls));
+        for (void* block = list.head; block; block = nextOf(block)) {
+            ++list.length;
+        }
+    }
+    void* block = list.head;
+    list.head = nextOf(block);
+    --list.length;
+    return block;
+}
+
+void ThreadCache::deallocate(void* ptr, size_t bytes) noexcept {
+    if (bytes > kMaxSmallSize) {
+        ::operator delete(ptr);
+        return;
+    }
+    const size_t cls = sizeClass(bytes);
+    auto& cache = t_cache;
+    if (!isLive(cache)) [[unlikely]] {
+        releaseChain(cls, ptr, ptr);
+        return;
+    }
+    auto& list = cache.lists[cls];
+    nextOf(ptr) = list.head;
+    list.head = ptr;
+    // Keep up to two batches so a thread alternating allocate and free around a boundary does
+    // not bounce one batch back and forth.
+    if (++list.length > 2 * batchSize(cls)) [[unlikely]] {
+        drain(list, cls, batchSize(cls));
+    }
+}
+
+void ThreadCache::recordAllocation(IMemoryManager& manager, void* ptr, size_t bytes, MemoryTag tag) {
+    auto* counters = manager.batchedCounters();
+    if (!counters || !accumulate(*counters, tag, static_cast<std::int64_t>(bytes), 1)) {
+        manager.registerAllocation(ptr, bytes, tag);
+    }
+}
+
+void ThreadCache::recordRelease(IMemoryManager& manager, void* ptr, size_t bytes, MemoryTag tag) noexcept {
+    auto* counters = manager.batchedCounters();
+    if (!counters || !accumulate(*counters, tag, -static_cast<std::int64_t>(bytes), -1)) {
+        manager.unregisterAllocation(ptr, bytes, tag);
+    }
+}
+
+void ThreadCache::flushAccounting() noexcept {
+    auto& cache = t_cache;
+    if (cache.pendingOps != 0) {
+        flushPending(cache);
+    }
+}
+
+void ThreadCache::releaseCachedBlocks() noexcept {
+    auto& cache = t_cache;
+    for (size_t cls = 0; cls < kSizeClassCount; ++cls) {
+        auto& list = cache.lists[cls];
+        if (list.length != 0) {
+            drain(list, cls, list.length);
+        }
+    }
+}
+
+size_t ThreadCache::cachedBlocks() noexcept {
+    size_t blocks = 0;
+    for (const auto& list : t_cache.lists) {
+        blocks += list.length;
+    }
+    return blocks;
+}
+
+} // namespace Memory::Core
@@ -1,8 +1,9 @@
 #include "Networking/NetworkManager.h"
 
+#include "Async/WhenAll.h"
+
 #include <algorithm>
 #include <cstdint>
-#include <thread>
 #include <vector>
 
 namespace soul::net {
@@ -26,6 +27,23 @@ NetworkManager::NetworkManager(std::shared_ptr<soul::async::TaskScheduler> sched
       m_tcp(std::move(tcpTransport)),
       m_udp(std::move(udpTransport)) {}
 
+NetworkManager::~NetworkManager() {
+    std::vector<soul::async::CancellationSource> outstanding;
+    {
+        std::lock_guard lock(m_mutex);
+        for (auto& [key, connection] : m_connections) {
+            for (auto& [channel, channelState] : connection.channels) {
+                for (auto& [sequence, entry] : channelState.pending) {
+                    outstanding.push_back(entry.cancellation);
+                }
+            }
+        }
+    }
+    for (auto& cancellation : outstanding) {
+        cancellation.cancel();
+    }
+}
+
 soul::async::Task<void> NetworkManager::send(const Endpoint& endpoint, Packet packet) {
     if (packet.header.guarantee == DeliveryGuarantee::Reliable && is_udp_reliable(packet.header.channel)) {
         co_await send_reliable_udp(endpoint, std::move(packet));
@@ -36,6 +54,36 @@ soul::async::Task<void> NetworkManager::send(const Endpoint& endpoint, Packet pa
     co_await transport->send(endpoint, std::move(packet));
 }
 
+soul::async::Task<void> NetworkManager::send_batch(Endpoint endpoint, std::vector<Packet> packets) {
+    std::vector<soul::async::Task<void>> sends;
+    sends.reserve(packets.size());
+    for (auto& packet : packets) {
+        sends.push_back(send(endpoint, std::move(packet)));
+    }
+    // `endpoint` lives in this frame, which outlives every send since they are all joined here.
+    auto join = soul::async::when_all(std::move(sends));
+    co_await join;
+}
+
+soul::async::AsyncGenerator<std::pair<Endpoint, Packet>> NetworkManager::receive_stream(
+    soul::async::CancellationToken cancellation,
+    std::chrono::milliseconds idleDelay) {
+    while (!cancellation.is_cancellation_requested()) {
+        auto next = receive();
+        auto received = co_await next;
+        if (received) {
+            co_yield std::move(*received);
+            continue;
+        }
+        auto idle = m_scheduler->sleep_for(idleDelay, cancellation);
+        try {
+            co_await idle;
+        } catch (const soul::async::OperationCancelled&) {
+            co_return;
+        }
+    }
+}
+
 soul::async::Task<std::optional<std::pair<Endpoint, Packet>>> NetworkManager::receive() {
     if (auto reliable = co_await m_tcp->receive(); reliable.has_value()) {
         co_return reliable;
@@ -115,30 +163,37 @@ soul::async::Task<void> NetworkManager::send_reliable_udp(const Endpoint& endpoi
     }
 
     co_await m_udp->send(endpoint, std::move(packet));
-    schedule_retransmission(endpoint, pendingCopy.packet.header.channel, sequence);
+    schedule_retransmission(endpoint, pendingCopy.packet.header.channel, sequence, pendingCopy.cancellation.token());
 }
 
 void NetworkManager::record_ack(const Endpoint& endpoint, const PacketHeader& header) {
-    std::lock_guard lock(m_mutex);
-    auto connectionIt = m_connections.find(make_connection_key(endpoint));
-    if (connectionIt == m_connections.end()) {
-        return;
-    }
+    std::vector<soul::async::CancellationSource> acknowledged;
+    {
+        std::lock_guard lock(m_mutex);
+        auto connectionIt = m_connections.find(make_connection_key(endpoint));
+        if (connectionIt == m_connections.end()) {
+            return;
+        }
 
-    auto channelIt = connectionIt->second.channels.find(header.channel);
-    if (channelIt == connectionIt->second.channels.end()) {
-        return;
-    }
+        auto channelIt = connectionIt->second.channels.find(header.channel);
+        if (channelIt == connectionIt->second.channels.end()) {
+            return;
+        }
 
-    auto& pending = channelIt->second.pending;
-    std::vector<std::uint32_t> sequencesToErase;
-    for (auto& [sequence, entry] : pending) {
-        if (is_sequence_acked(sequence, header.acknowledgment, header.acknowledgmentMask)) {
-            sequencesToErase.emplace_back(sequence);
+        auto& pending = channelIt->second.pending;
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (is_sequence_acked(it->first, header.acknowledgment, header.acknowledgmentMask)) {
+                acknowledged.push_back(std::move(it->second.cancellation));
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
-    for (auto seq : sequencesToErase) {
-        pending.erase(seq);
+
+    // Wake the retry timers outside the lock; each retransmission task then finishes at once.
+    for (auto& cancellation : acknowledged) {
+        cancellation.cancel();
     }
 }
 
@@ -226,14 +281,16 @@ void NetworkManager::maybe_send_ack(const Endpoint& endpoint, std::uint16_t chan
 
 void NetworkManager::schedule_retransmission(const Endpoint& endpoint,
                                              std::uint16_t channel,
-                                             std::uint32_t sequence) {
-    auto task = retransmit_after(endpoint, channel, sequence);
-    m_scheduler->schedule(std::move(task));
+                                             std::uint32_t sequence,
+                                             const soul::async::CancellationToken& cancellation) {
+    auto task = retransmit_after(endpoint, channel, sequence, cancellation);
+    m_scheduler->schedule(std::move(task), cancellation, soul::async::TaskPriority::High);
 }
 
 soul::async::Task<void> NetworkManager::retransmit_after(Endpoint endpoint,
                                                          std::uint16_t channel,
-                                                         std::uint32_t sequence) {
+                                                         std::uint32_t sequence,
+                                                         soul::async::CancellationToken cancellation) {
     std::chrono::milliseconds waitDuration;
     std::uint8_t maxAttempts;
 
@@ -243,9 +300,8 @@ soul::async::Task<void> NetworkManager::retransmit_after(Endpoint endpoint,
         maxAttempts = m_maxRetransmitAttempts;
     }
 
-    co_await m_scheduler->run_async([waitDuration]() {
-        std::this_thread::sleep_for(waitDuration);
-    });
+    // Throws `OperationCancelled` as soon as the packet is acknowledged, ending the task.
+    co_await m_scheduler->sleep_for(waitDuration, cancellation, soul::async::TaskPriority::High);
 
     PendingPacket packetToResend;
     bool shouldRetry = false;
@@ -282,7 +338,7 @@ soul::async::Task<void> NetworkManager::retransmit_after(Endpoint endpoint,
 
     if (shouldRetry) {
         co_await m_udp->send(packetToResend.endpoint, packetToResend.packet);
-        schedule_retransmission(endpoint, channel, sequence);
+        schedule_retransmission(endpoint, channel, sequence, cancellation);
     }
 }
 
@@ -84,7 +84,8 @@ void TcpTransport::close() {
 
 soul::async::Task<void> TcpTransport::send(const Endpoint& endpoint, Packet packet) {
     auto scheduler = m_scheduler;
-    co_await scheduler->run_async([endpoint, packet = std::move(packet)]() mutable {
+    // Build the job outside the co_await expression; see ThreadPoolAsyncFileIO::read.
+    auto task = scheduler->run_async([endpoint, packet = std::move(packet)]() mutable {
         platform::SocketHandle socket = create_tcp_socket();
         if (socket == platform::invalid_socket) {
             return;
@@ -123,6 +124,7 @@ soul::async::Task<void> TcpTransport::send(const Endpoint& endpoint, Packet pack
     }
         platform::close_socket(socket);
     });
+    co_await task;
 }
 
 soul::async::Task<std::optional<std::pair<Endpoint, Packet>>> TcpTransport::receive() {
@@ -85,21 +85,25 @@ soul::async::Task<void> UdpTransport::send(const Endpoint& endpoint, Packet pack
     addr.sin_port = endpoint.port;
     addr.sin_addr.s_addr = endpoint.address;
 
+    // A datagram send does not wait for the peer, so it runs on the pool directly: a caller that
+    // is already on one of the scheduler's workers sends inline instead of queueing a job.
+    const auto socket = m_socket;
     auto scheduler = m_scheduler;
-    co_await scheduler->run_async([socket = m_socket, addr, packet = std::move(packet)]() mutable {
-        auto headerBytes = encode_header(packet.header);
-        std::vector<std::byte> buffer;
-        buffer.reserve(headerBytes.size() + packet.payload.size());
-        buffer.insert(buffer.end(), headerBytes.begin(), headerBytes.end());
-        buffer.insert(buffer.end(), packet.payload.begin(), packet.payload.end());
-
-        ::sendto(socket,
-                 reinterpret_cast<const char*>(buffer.data()),
-                 static_cast<int>(buffer.size()),
-                 0,
-                 reinterpret_cast<const sockaddr*>(&addr),
-                 sizeof(addr));
-    });
+    auto hop = scheduler->schedule_on(soul::async::TaskPriority::High);
+    co_await hop;
+
+    auto headerBytes = encode_header(packet.header);
+    std::vector<std::byte> buffer;
+    buffer.reserve(headerBytes.size() + packet.payload.size());
+    buffer.insert(buffer.end(), headerBytes.begin(), headerBytes.end());
+    buffer.insert(buffer.end(), packet.payload.begin(), packet.payload.end());
+
+    ::sendto(socket,
+             reinterpret_cast<const char*>(buffer.data()),
+             static_cast<int>(buffer.size()),
+             0,
+             reinterpret_cast<const sockaddr*>(&addr),
+             sizeof(addr));
 }
 
 soul::async::Task<std::optional<std::pair<Endpoint, Packet>>> UdpTransport::receive() {
@@ -108,7 +112,7 @@ soul::async::Task<std::optional<std::pair<Endpoint, Packet>>> UdpTransport::rece
     }
 
     auto scheduler = m_scheduler;
-    co_return co_await scheduler->run_async([socket = m_socket]() -> std::optional<std::pair<Endpoint, Packet>> {
+    co_return co_await scheduler->run_async(soul::async::TaskPriority::High, [socket = m_socket]() -> std::optional<std::pair<Endpoint, Packet>> {
     std::array<std::byte, 1500> buffer{};
     sockaddr_in from{};
 #if defined(_WIN32)
@@ -0,0 +1,334 @@
+#include "time/FrameGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+namespace soul::time {
+
+namespace {
+
+constexpr std::uint32_t kNoNode = ~std::uint32_t{0};
+
+} // namespace
+
+struct FrameGraph::Compiled {
+    struct Node {
+        std::string name;
+        std::function<void()> job;
+        soul::async::TaskPriority priority{soul::async::TaskPriority::High};
+        std::uint32_t dependencyCount{0};
+        // Range of this node's entries in `dependents`.
+        std::uint32_t firstDependent{0};
+        std::uint32_t dependentCount{0};
+        NodeId builderId{0};
+        // Interned name, valid for `tracedBy`; only touched by the thread running the node.
+        soul::async::Tracer* tracedBy{nullptr};
+        const char* traceName{nullptr};
+    };
+
+    std::shared_ptr<soul::async::TaskScheduler> scheduler;
+    // Topological order; `dependents` and `roots` hold indices into it.
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> dependents;
+    std::vector<std::uint32_t> roots;
+    std::vector<std::uint32_t> slotOf;
+    std::unique_ptr<std::atomic_uint32_t[]> pending;
+    // One more than the nodes of the current replay that have not finished; zero when idle.
+    // The last node drops it to one, wakes the waiters, then stores zero as its final access
+    // to the graph, so a waiter that sees zero may destroy the graph at once.
+    std::atomic_uint32_t remaining{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// Scheduler job for one node. A job destroyed without running, because the scheduler dropped it
+// after `stop` or could not queue it, runs its node inline instead, so a replay always finishes.
+struct FrameGraph::NodeJob {
+    Compiled* graph;
+    std::uint32_t index;
+
+    NodeJob(Compiled& graph, std::uint32_t index) noexcept
+        : graph(&graph), index(index) {}
+
+    NodeJob(NodeJob&& other) noexcept
+        : graph(std::exchange(other.graph, nullptr)), index(other.index) {}
+
+    NodeJob(const NodeJob&) = delete;
+    NodeJob& operator=(const NodeJob&) = delete;
+    NodeJob& operator=(NodeJob&&) = delete;
+
+    ~NodeJob() {
+        if (graph) {
+            run_node(*graph, index);
+        }
+    }
+
+    void operator()() noexcept {
+        run_node(*std::exchange(graph, nullptr), index);
+    }
+};
+
+FrameGraph::NodeId FrameGraph::Builder::add(std::string name,
+                                            std::function<void()> job,
+                                            std::span<const NodeId> dependencies,
+                                            soul::async::TaskPriority priority) {
+    const auto id = static_cast<NodeId>(m_nodes.size());
+    m_nodes.push_back(PendingNode{std::move(name), std::move(job), priority});
+    for (const auto dependency : dependencies) {
+        m_edges.emplace_back(id, dependency);
+    }
+    return id;
+}
+
+FrameGraph::Builder& FrameGraph::Builder::depends_on(NodeId node, NodeId dependency) {
+    m_edges.emplace_back(node, dependency);
+    return *this;
+}
+
+FrameGraph FrameGraph::Builder::compile(std::shared_ptr<soul::async::TaskScheduler> scheduler) const {
+    if (!scheduler) {
+        throw std::invalid_argument("FrameGraph: no scheduler");
+    }
+
+    const auto count = static_cast<std::uint32_t>(m_nodes.size());
+    std::unordered_set<std::string_view> names;
+    for (const auto& node : m_nodes) {
+        if (!names.insert(node.name).second) {
+            throw std::invalid_argument("FrameGraph: duplicate node name '" + node.name + "'");
+        }
+        if (!node.job) {
+            throw std::invalid_argument("FrameGraph: node '" + node.name + "' has no job");
+        }
+    }
+
+    auto edges = m_edges;
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<std::vector<NodeId>> dependentsOf(count);
+    std::vector<std::uint32_t> indegree(count, 0);
+    for (const auto& [node, dependency] : edges) {
+        if (node >= count || dependency >= count) {
+            throw std::invalid_argument("FrameGraph: dependency edge refers to an unknown node id");
+        }
+        dependentsOf[dependency].push_back(node);
+        ++indegree[node];
+    }
+
+    // Kahn's algorithm; ties keep insertion order so the layout is deterministic.
+    std::vector<NodeId> order;
+    order.reserve(count);
+    std::deque<NodeId> ready;
+    for (NodeId id = 0; id < count; ++id) {
+        if (indegree[id] == 0) {
+            ready.push_back(id);
+        }
+    }
+    auto remainingIndegree = indegree;
+    while (!ready.empty()) {
+        const auto id = ready.front();
+        ready.pop_front();
+        order.push_back(id);
+        for (const auto dependent : dependentsOf[id]) {
+            if (--remainingIndegree[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+    if (order.size() != count) {
+        std::string cycle;
+        for (NodeId id = 0; id < count; ++id) {
+            if (remainingIndegree[id] != 0) {
+                cycle += cycle.empty() ? "" : ", ";
+                cycle += m_nodes[id].name;
+            }
+        }
+        throw std::invalid_argument("FrameGraph: dependency cycle through " + cycle);
+    }
+
+    auto compiled = std::make_unique<Compiled>();
+    compiled->scheduler = std::move(scheduler);
+    compiled->slotOf.resize(count);
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        compiled->slotOf[order[slot]] = slot;
+    }
+    compiled->nodes.resize(count);
+    compiled->dependents.reserve(edges.size());
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        const auto id = order[slot];
+        auto& node = compiled->nodes[slot];
+        node.name = m_nodes[id].name;
+        node.job = m_nodes[id].job;
+        node.priority = m_nodes[id].priority;
+        node.builderId = id;
+        node.dependencyCount = indegree[id];
+        node.firstDependent = static_cast<std::uint32_t>(compiled->dependents.size());
+        node.dependentCount = static_cast<std::uint32_t>(dependentsOf[id].size());
+        for (const auto dependent : dependentsOf[id]) {
+            compiled->dependents.push_back(compiled->slotOf[dependent]);
+        }
+        if (node.dependencyCount == 0) {
+            compiled->roots.push_back(slot);
+        }
+    }
+    compiled->pending = std::make_unique<std::atomic_uint32_t[]>(count);
+    return FrameGraph(std::move(compiled));
+}
+
+FrameGraph::FrameGraph(std::unique_ptr<Compiled> compiled) noexcept
+    : m_compiled(std::move(compiled)) {}
+
+FrameGraph::FrameGraph(FrameGraph&&) noexcept = default;
+
+FrameGraph& FrameGraph::operator=(FrameGraph&& other) noexcept {
+    if (this != &other) {
+        // Queued jobs point at the compiled graph being replaced; let them drain first.
+        try {
+            wait();
+        } catch (...) {
+        }
+        m_compiled = std::move(other.m_compiled);
+    }
+    return *this;
+}
+
+FrameGraph::~FrameGraph() {
+    // Queued jobs point at the compiled graph; let them drain first.
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void FrameGraph::dispatch() {
+    if (!m_compiled) {
+        return;
+    }
+    auto& graph = *m_compiled;
+    if (graph.remaining.load(std::memory_order_acquire) != 0) {
+        throw std::logic_error("FrameGraph: dispatch while the previous replay is still running");
+    }
+    if (graph.nodes.empty()) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < graph.nodes.size(); ++i) {
+        graph.pending[i].store(graph.nodes[i].dependencyCount, std::memory_order_relaxed);
+    }
+    graph.error = nullptr;
+    // Queuing a job publishes the resets above to the worker that runs it.
+    graph.remaining.store(static_cast<std::uint32_t>(graph.nodes.size()) + 1, std::memory_order_release);
+    for (const auto root : graph.roots) {
+        enqueue_node(graph, root);
+    }
+}
+
+void FrameGraph::wait() {
+    if (!m_compiled) {
+        return;
+    }
+    auto& graph = *m_compiled;
+    auto remaining = graph.remaining.load(std::memory_order_acquire);
+    while (remaining != 0) {
+        if (remaining == 1) {
+            // The last node is waking waiters; it stores zero right after.
+            std::this_thread::yield();
+        } else {
+            graph.remaining.wait(remaining, std::memory_order_acquire);
+        }
+        remaining = graph.remaining.load(std::memory_order_acquire);
+    }
+    if (graph.error) {
+        std::rethrow_exception(std::exchange(graph.error, nullptr));
+    }
+}
+
+void FrameGraph::execute() {
+    dispatch();
+    wait();
+}
+
+std::size_t FrameGraph::size() const noexcept {
+    return m_compiled ? m_compiled->nodes.size() : 0;
+}
+
+const std::string& FrameGraph::name(NodeId node) const {
+    if (!m_compiled) {
+        throw std::out_of_range("FrameGraph: moved-from graph has no nodes");
+    }
+    return m_compiled->nodes.at(m_compiled->slotOf.at(node)).name;
+}
+
+std::vector<FrameGraph::NodeId> FrameGraph::topological_order() const {
+    std::vector<NodeId> order;
+    if (!m_compiled) {
+        return order;
+    }
+    order.reserve(m_compiled->nodes.size());
+    for (const auto& node : m_compiled->nodes) {
+        order.push_back(node.builderId);
+    }
+    return order;
+}
+
+void FrameGraph::enqueue_node(Compiled& graph, std::uint32_t index) noexcept {
+    try {
+        graph.scheduler->enqueue(NodeJob(graph, index), graph.nodes[index].priority);
+    } catch (...) {
+        // No job node available; the node already ran when its job was destroyed.
+    }
+}
+
+void FrameGraph::run_node(Compiled& graph, std::uint32_t index) noexcept {
+    while (index != kNoNode) {
+        auto& node = graph.nodes[index];
+        try {
+            auto* tracer = graph.scheduler->active_tracer();
+            if (tracer && node.tracedBy != tracer) {
+                node.traceName = tracer->intern(node.name);
+                node.tracedBy = tracer;
+            }
+            const auto start = soul::async::Tracer::Clock::now();
+            node.job();
+            if (tracer) {
+                tracer->slice(node.traceName, start, soul::async::Tracer::Clock::now());
+            }
+        } catch (...) {
+            std::lock_guard lock(graph.errorMutex);
+            if (!graph.error) {
+                graph.error = std::current_exception();
+            }
+        }
+
+        // Keep the first released dependent for this thread and queue the others.
+        auto next = kNoNode;
+        for (std::uint32_t i = 0; i < node.dependentCount; ++i) {
+            const auto dependent = graph.dependents[node.firstDependent + i];
+            if (graph.pending[dependent].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                continue;
+            }
+            if (next == kNoNode) {
+                next = dependent;
+                continue;
+            }
+            enqueue_node(graph, dependent);
+        }
+
+        if (graph.remaining.fetch_sub(1, std::memory_order_acq_rel) == 2) {
+            graph.remaining.notify_all();
+            graph.remaining.store(0, std::memory_order_release);
+            return;
+        }
+        index = next;
+    }
+}
+
+} // namespace soul::time
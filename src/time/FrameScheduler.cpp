@@ -1,10 +1,17 @@
 #include "time/FrameScheduler.h"
 
-#include <thread>
-#include <vector>
+#include <algorithm>
 
 namespace soul::time {
 
+namespace {
+
+std::int64_t nanoseconds_since(FrameScheduler::Clock::time_point start) noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(FrameScheduler::Clock::now() - start).count();
+}
+
+} // namespace
+
 FrameScheduler::FrameScheduler(std::shared_ptr<soul::async::TaskScheduler> scheduler)
     : m_scheduler(std::move(scheduler)) {}
 
@@ -12,10 +19,14 @@ FrameScheduler::TaskHandle FrameScheduler::schedule(
     std::string name,
     soul::async::Task<void> task,
     std::span<const soul::async::TaskToken> dependencies) {
-    auto scheduled = m_scheduler->schedule(std::move(task), dependencies);
-    auto token = scheduled.token();
-    m_tokens.emplace(std::move(name), token);
-    return TaskHandle{std::move(scheduled), token};
+    auto* record = begin_job(name, dependencies);
+    soul::async::CancellationSource cancellation;
+    auto scheduled = m_scheduler->schedule(record ? run_recorded(std::move(task), *record, m_frameStart) : std::move(task),
+                                           cancellation.token(),
+                                           soul::async::TaskPriority::High,
+                                           dependencies,
+                                           name);
+    return track(name, std::move(scheduled), std::move(cancellation), record);
 }
 
 FrameScheduler::TaskHandle FrameScheduler::schedule_after(
@@ -23,24 +34,211 @@ FrameScheduler::TaskHandle FrameScheduler::schedule_after(
     std::string name,
     soul::async::Task<void> task,
     std::span<const soul::async::TaskToken> dependencies) {
-    auto scheduler = m_scheduler;
-    auto delayTask = scheduler->schedule([delay]() mutable -> soul::async::Task<void> {
-        std::this_thread::sleep_for(delay);
-        co_return;
-    }());
+    auto* record = begin_job(name, dependencies);
+    // The delay is a timer-wheel dependency rather than a sleeping job, so no worker is held.
+    soul::async::CancellationSource cancellation;
+    auto scheduled = m_scheduler->schedule_at(soul::async::TaskScheduler::Clock::now() + delay,
+                                              record ? run_recorded(std::move(task), *record, m_frameStart) : std::move(task),
+                                              soul::async::TaskPriority::High,
+                                              dependencies,
+                                              cancellation.token(),
+                                              name);
+    return track(name, std::move(scheduled), std::move(cancellation), record);
+}
 
-    std::vector<soul::async::TaskToken> combinedDeps;
-    combinedDeps.reserve(dependencies.size() + 1);
-    combinedDeps.insert(combinedDeps.end(), dependencies.begin(), dependencies.end());
-    combinedDeps.emplace_back(delayTask.token());
+bool FrameScheduler::cancel(const std::string& name) {
+    const auto it = m_jobIds.find(name);
+    if (it == m_jobIds.end()) {
+        return false;
+    }
+    auto& job = m_jobs[it->second];
+    if (job.frame == m_frame && job.record) {
+        job.record->cancelled = true;
+    }
+    return job.cancellation.cancel();
+}
 
-    return schedule(std::move(name), std::move(task), std::span<const soul::async::TaskToken>(combinedDeps.data(), combinedDeps.size()));
+std::uint64_t FrameScheduler::begin_frame() {
+    end_frame();
+    open_frame();
+    return m_frame;
+}
+
+void FrameScheduler::end_frame() {
+    wait_for_all();
+    for (const auto& [name, index] : m_jobIds) {
+        auto& job = m_jobs[index];
+        job.token = {};
+        job.record = nullptr;
+        m_freeJobs.push_back(index);
+    }
+    m_jobIds.clear();
 }
 
 void FrameScheduler::wait_for_all() {
-    for (auto& [name, token] : m_tokens) {
+    for (const auto& token : m_superseded) {
         m_scheduler->wait(token);
     }
+    m_superseded.clear();
+    for (const auto index : m_live) {
+        m_scheduler->wait(m_jobs[index].token);
+        m_jobs[index].live = false;
+    }
+    m_live.clear();
+    m_frameOpen = false;
+}
+
+FrameScheduler::GraphSnapshot FrameScheduler::snapshot() const {
+    GraphSnapshot graph;
+    graph.frame = m_frame;
+    graph.nodes.reserve(m_graph.size());
+    for (const auto& record : m_graph) {
+        GraphNode node;
+        node.id = static_cast<std::uint32_t>(graph.nodes.size());
+        node.name = record.name;
+        node.dependencies = record.dependencies;
+        node.scheduledAt = std::chrono::nanoseconds(record.scheduledAt);
+        const auto startedAt = record.startedAt.load(std::memory_order_relaxed);
+        const auto finishedAt = record.finishedAt.load(std::memory_order_relaxed);
+        if (finishedAt >= 0) {
+            node.state = NodeState::Completed;
+        } else if (startedAt >= 0) {
+            node.state = NodeState::Running;
+        } else if (record.cancelled) {
+            node.state = NodeState::Cancelled;
+        }
+        node.startedAt = std::chrono::nanoseconds(std::max<std::int64_t>(startedAt, 0));
+        node.finishedAt = std::chrono::nanoseconds(std::max<std::int64_t>(finishedAt, 0));
+        graph.nodes.push_back(std::move(node));
+    }
+    return graph;
+}
+
+std::vector<std::uint32_t> FrameScheduler::GraphSnapshot::critical_path() const {
+    std::vector<std::uint32_t> path;
+    const GraphNode* current = nullptr;
+    for (const auto& node : nodes) {
+        if (node.state == NodeState::Completed && (!current || node.finishedAt > current->finishedAt)) {
+            current = &node;
+        }
+    }
+
+    while (current) {
+        path.push_back(current->id);
+        const GraphNode* gate = nullptr;
+        for (const auto dependency : current->dependencies) {
+            const auto& candidate = nodes[dependency];
+            if (candidate.state == NodeState::Completed && (!gate || candidate.finishedAt > gate->finishedAt)) {
+                gate = &candidate;
+            }
+        }
+        current = gate;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::chrono::nanoseconds FrameScheduler::GraphSnapshot::makespan() const noexcept {
+    std::chrono::nanoseconds latest{0};
+    for (const auto& node : nodes) {
+        if (node.state == NodeState::Completed) {
+            latest = std::max(latest, node.finishedAt);
+        }
+    }
+    return latest;
+}
+
+soul::async::Task<void> FrameScheduler::run_recorded(soul::async::Task<void> task,
+                                                     GraphRecord& record,
+                                                     Clock::time_point frameStart) {
+    record.startedAt.store(nanoseconds_since(frameStart), std::memory_order_relaxed);
+    try {
+        co_await task;
+    } catch (...) {
+        record.finishedAt.store(nanoseconds_since(frameStart), std::memory_order_relaxed);
+        throw;
+    }
+    // Stored before the wrapper completes, so nothing touches the record once the frame is waited on.
+    record.finishedAt.store(nanoseconds_since(frameStart), std::memory_order_relaxed);
+}
+
+void FrameScheduler::open_frame() {
+    // Every job of the closed frame has been waited on, so nothing writes to its records.
+    if (m_frameUsed) {
+        m_graph.clear();
+        m_graphIds.clear();
+        ++m_frame;
+        m_frameUsed = false;
+    }
+    m_frameOpen = true;
+    m_frameStart = Clock::now();
+}
+
+FrameScheduler::GraphRecord* FrameScheduler::begin_job(const std::string& name,
+                                                       std::span<const soul::async::TaskToken> dependencies) {
+    if (!m_frameOpen) {
+        open_frame();
+    }
+    m_frameUsed = true;
+    if (!m_recordGraph) {
+        return nullptr;
+    }
+
+    auto& record = m_graph.emplace_back();
+    record.name = name;
+    record.scheduledAt = nanoseconds_since(m_frameStart);
+    for (const auto& dependency : dependencies) {
+        // Tokens from earlier frames or from outside the frame scheduler are not graph edges.
+        const auto it = m_graphIds.find(dependency.state().get());
+        if (it != m_graphIds.end()) {
+            record.dependencies.push_back(it->second);
+        }
+    }
+    return &record;
+}
+
+FrameScheduler::TaskHandle FrameScheduler::track(const std::string& name,
+                                                 soul::async::Task<void> scheduled,
+                                                 soul::async::CancellationSource cancellation,
+                                                 GraphRecord* record) {
+    auto token = scheduled.token();
+    if (record) {
+        m_graphIds[token.state().get()] = static_cast<std::uint32_t>(m_graph.size() - 1);
+    }
+
+    const auto it = m_jobIds.find(name);
+    std::uint32_t index = 0;
+    if (it != m_jobIds.end()) {
+        index = it->second;
+        auto& previous = m_jobs[index];
+        if (previous.frame == m_frame && previous.record) {
+            previous.record->cancelled = true;
+        }
+        previous.cancellation.cancel();
+        m_superseded.push_back(std::move(previous.token));
+    } else {
+        if (m_freeJobs.empty()) {
+            index = static_cast<std::uint32_t>(m_jobs.size());
+            m_jobs.emplace_back();
+        } else {
+            index = m_freeJobs.back();
+            m_freeJobs.pop_back();
+        }
+        // Reuses the slot's buffer; the key views it, so assign before inserting.
+        m_jobs[index].name.assign(name);
+        m_jobIds.emplace(m_jobs[index].name, index);
+    }
+
+    auto& job = m_jobs[index];
+    job.token = token;
+    job.cancellation = std::move(cancellation);
+    job.record = record;
+    job.frame = m_frame;
+    if (!job.live) {
+        job.live = true;
+        m_live.push_back(index);
+    }
+    return TaskHandle{std::move(scheduled), token};
 }
 
 } // namespace soul::time
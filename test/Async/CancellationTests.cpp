@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "Async/Cancellation.h"
+#include "Async/Task.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+soul::async::Task<void> SetFlag(std::atomic_bool& flag) {
+    flag = true;
+    co_return;
+}
+
+soul::async::Task<void> SleepFor(soul::async::TaskScheduler& scheduler,
+                                 std::chrono::milliseconds duration,
+                                 soul::async::CancellationToken cancellation,
+                                 std::atomic_bool& woke) {
+    co_await scheduler.sleep_for(duration, cancellation);
+    woke = true;
+}
+
+} // namespace
+
+TEST(Cancellation, SourceSignalsItsTokensOnce) {
+    soul::async::CancellationToken detached;
+    EXPECT_FALSE(detached.can_be_cancelled());
+    EXPECT_FALSE(detached.is_cancellation_requested());
+
+    soul::async::CancellationSource source;
+    const auto token = source.token();
+    EXPECT_TRUE(token.can_be_cancelled());
+    EXPECT_FALSE(token.is_cancellation_requested());
+    EXPECT_NO_THROW(token.throw_if_cancellation_requested());
+
+    EXPECT_TRUE(source.cancel());
+    EXPECT_FALSE(source.cancel());
+    EXPECT_TRUE(token.is_cancellation_requested());
+    EXPECT_THROW(token.throw_if_cancellation_requested(), soul::async::OperationCancelled);
+}
+
+TEST(Cancellation, RunAsyncSkipsWorkCancelledWhileQueued) {
+    soul::async::TaskScheduler scheduler(1);
+    std::promise<void> gate;
+    auto gateFuture = gate.get_future().share();
+    auto blocker = scheduler.run_async([gateFuture]() { gateFuture.wait(); });
+
+    soul::async::CancellationSource source;
+    std::atomic_bool ran{false};
+    auto skipped = scheduler.run_async(source.token(), soul::async::TaskPriority::Normal, [&ran]() {
+        ran = true;
+        return 1;
+    });
+
+    source.cancel();
+    gate.set_value();
+    EXPECT_THROW(skipped.get(), soul::async::OperationCancelled);
+    EXPECT_FALSE(ran.load());
+    blocker.get();
+}
+
+TEST(Cancellation, AlreadyCancelledTaskIsNeverResumed) {
+    soul::async::TaskScheduler scheduler(2);
+    soul::async::CancellationSource source;
+    source.cancel();
+
+    std::atomic_bool ran{false};
+    auto task = scheduler.schedule(SetFlag(ran), source.token());
+    scheduler.wait(task.token());
+
+    EXPECT_THROW(task.get(), soul::async::OperationCancelled);
+    EXPECT_FALSE(ran.load());
+}
+
+TEST(Cancellation, BlockedTaskReleasesDependentsWithoutWaitingForItsDependencies) {
+    soul::async::TaskScheduler scheduler(2);
+    std::promise<void> gate;
+    auto gateFuture = gate.get_future().share();
+    auto upstream = scheduler.run_async([gateFuture]() { gateFuture.wait(); });
+
+    soul::async::CancellationSource source;
+    std::atomic_bool middleRan{false};
+    std::atomic_bool downstreamRan{false};
+    const std::array<soul::async::TaskToken, 1> upstreamDeps{upstream.token()};
+    auto middle = scheduler.schedule(SetFlag(middleRan), source.token(), soul::async::TaskPriority::Normal, upstreamDeps);
+    const std::array<soul::async::TaskToken, 1> middleDeps{middle.token()};
+    auto downstream = scheduler.schedule(SetFlag(downstreamRan), middleDeps);
+
+    source.cancel();
+    // Completes while `upstream` is still blocked: the cancelled task no longer gates anything.
+    scheduler.wait(downstream.token());
+    EXPECT_TRUE(downstreamRan.load());
+    EXPECT_THROW(middle.get(), soul::async::OperationCancelled);
+
+    gate.set_value();
+    upstream.get();
+    EXPECT_FALSE(middleRan.load());
+}
+
+TEST(Cancellation, CancelledSleepWakesImmediately) {
+    soul::async::TaskScheduler scheduler(1);
+    soul::async::CancellationSource source;
+    std::atomic_bool woke{false};
+
+    const auto start = Clock::now();
+    auto sleeper = scheduler.schedule(SleepFor(scheduler, std::chrono::seconds(30), source.token(), woke));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    source.cancel();
+
+    EXPECT_THROW(sleeper.get(), soul::async::OperationCancelled);
+    EXPECT_LT(Clock::now() - start, std::chrono::seconds(5));
+    EXPECT_FALSE(woke.load());
+}
+
+TEST(Cancellation, UncancelledSleepCompletesNormally) {
+    soul::async::TaskScheduler scheduler(1);
+    soul::async::CancellationSource source;
+    std::atomic_bool woke{false};
+
+    auto sleeper = scheduler.schedule(SleepFor(scheduler, std::chrono::milliseconds(5), source.token(), woke));
+    EXPECT_NO_THROW(sleeper.get());
+    EXPECT_TRUE(woke.load());
+
+    // Cancelling after the fact is harmless.
+    EXPECT_TRUE(source.cancel());
+}
+
+TEST(Cancellation, ManyConcurrentCancellationsResolveEveryTask) {
+    soul::async::TaskScheduler scheduler(2);
+    constexpr int kTasks = 256;
+    std::vector<soul::async::CancellationSource> sources(kTasks);
+    std::vector<soul::async::Task<void>> sleepers;
+    std::atomic_bool woke{false};
+    for (int i = 0; i < kTasks; ++i) {
+        sleepers.push_back(scheduler.schedule(
+            SleepFor(scheduler, std::chrono::milliseconds(i % 4), sources[i].token(), woke), sources[i].token()));
+    }
+    for (auto& source : sources) {
+        source.cancel();
+    }
+    for (auto& sleeper : sleepers) {
+        scheduler.wait(sleeper.token());
+    }
+    SUCCEED();
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Async/AsyncGenerator.h"
+#include "Async/Channel.h"
+#include "Async/Task.h"
+#include "Async/WhenAll.h"
+
+namespace {
+
+soul::async::AsyncGenerator<int> Range(int count) {
+    for (int i = 0; i < count; ++i) {
+        co_yield i;
+    }
+}
+
+soul::async::AsyncGenerator<int> SlowRange(soul::async::TaskScheduler& scheduler, int count) {
+    for (int i = 0; i < count; ++i) {
+        auto value = scheduler.run_async([i]() { return i * 10; });
+        co_yield co_await value;
+    }
+}
+
+soul::async::AsyncGenerator<std::string> FailAfterOne() {
+    co_yield std::string("first");
+    throw std::runtime_error("broken stream");
+}
+
+template <typename T>
+soul::async::Task<std::vector<T>> Collect(soul::async::AsyncGenerator<T>& generator) {
+    std::vector<T> values;
+    while (true) {
+        auto next = generator.next();
+        auto value = co_await next;
+        if (!value) {
+            break;
+        }
+        values.push_back(std::move(*value));
+    }
+    co_return values;
+}
+
+} // namespace
+
+TEST(AsyncGenerator, YieldsLazilyAndAcrossAwaits) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+
+    auto range = Range(5);
+    EXPECT_FALSE(range.done());
+    EXPECT_EQ(Collect(range).get(), (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_TRUE(range.done());
+
+    auto slow = SlowRange(*scheduler, 4);
+    EXPECT_EQ(Collect(slow).get(), (std::vector<int>{0, 10, 20, 30}));
+
+    // Abandoning a generator halfway destroys its suspended frame.
+    auto partial = Range(100);
+    auto first = [&]() -> soul::async::Task<int> {
+        auto next = partial.next();
+        auto value = co_await next;
+        co_return value.value_or(-1);
+    };
+    EXPECT_EQ(first().get(), 0);
+}
+
+TEST(AsyncGenerator, RethrowsFromTheBody) {
+    auto failing = FailAfterOne();
+    auto consume = [&]() -> soul::async::Task<std::string> {
+        auto next = failing.next();
+        auto value = co_await next;
+        auto again = failing.next();
+        co_await again;
+        co_return *value;
+    };
+    EXPECT_THROW(consume().get(), std::runtime_error);
+}
+
+TEST(Channel, TrySendAndReceiveRespectCapacityAndClose) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    soul::async::Channel<int> channel(scheduler, 2);
+
+    EXPECT_TRUE(channel.try_send(1));
+    EXPECT_TRUE(channel.try_send(2));
+    EXPECT_FALSE(channel.try_send(3));
+    EXPECT_EQ(channel.size(), 2u);
+    EXPECT_EQ(channel.try_receive(), 1);
+
+    channel.close();
+    EXPECT_TRUE(channel.is_closed());
+    EXPECT_FALSE(channel.try_send(4));
+    EXPECT_EQ(channel.try_receive(), 2);
+    EXPECT_EQ(channel.try_receive(), std::nullopt);
+}
+
+TEST(Channel, ProducersAndConsumersExchangeEveryValueWithBackpressure) {
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 3;
+    constexpr int kPerProducer = 500;
+
+    for (const std::size_t capacity : {std::size_t{0}, std::size_t{1}, std::size_t{8}}) {
+        auto scheduler = std::make_shared<soul::async::TaskScheduler>(4);
+        soul::async::Channel<int> channel(scheduler, capacity);
+        std::atomic_size_t maxBuffered{0};
+
+        auto produce = [&](int base) -> soul::async::Task<void> {
+            for (int i = 0; i < kPerProducer; ++i) {
+                auto send = channel.send(base + i);
+                EXPECT_TRUE(co_await send);
+                const auto buffered = channel.size();
+                auto seen = maxBuffered.load();
+                while (buffered > seen && !maxBuffered.compare_exchange_weak(seen, buffered)) {
+                }
+            }
+        };
+        auto consume = [&]() -> soul::async::Task<long long> {
+            long long sum = 0;
+            while (true) {
+                auto receive = channel.receive();
+                auto value = co_await receive;
+                if (!value) {
+                    break;
+                }
+                sum += *value;
+            }
+            co_return sum;
+        };
+
+        std::vector<soul::async::Task<long long>> consumers;
+        for (int i = 0; i < kConsumers; ++i) {
+            consumers.push_back(scheduler->schedule(consume()));
+        }
+        std::vector<soul::async::Task<void>> producers;
+        for (int i = 0; i < kProducers; ++i) {
+            producers.push_back(scheduler->schedule(produce(i * kPerProducer)));
+        }
+        for (auto& producer : producers) {
+            producer.get();
+        }
+        channel.close();
+
+        long long total = 0;
+        for (auto& consumer : consumers) {
+            total += consumer.get();
+        }
+        const long long count = kProducers * kPerProducer;
+        EXPECT_EQ(total, count * (count - 1) / 2) << "capacity " << capacity;
+        EXPECT_LE(maxBuffered.load(), capacity) << "capacity " << capacity;
+    }
+}
+
+TEST(Channel, CloseReleasesWaitingSenders) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    soul::async::Channel<int> channel(scheduler, 0);
+
+    auto blocked = [&]() -> soul::async::Task<bool> {
+        auto send = channel.send(7);
+        co_return co_await send;
+    };
+    auto task = scheduler->schedule(blocked());
+    channel.close();
+    // Either the sender was already waiting and is released with `false`, or it arrives after
+    // the close and is rejected straight away.
+    EXPECT_FALSE(task.get());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Async/FrameAllocator.h"
+#include "Async/Task.h"
+
+using soul::async::Task;
+using soul::async::detail::allocate_frame;
+using soul::async::detail::deallocate_frame;
+
+namespace {
+
+struct DestructionFlag {
+    explicit DestructionFlag(std::shared_ptr<bool> flag) : destroyed(std::move(flag)) {}
+    DestructionFlag(DestructionFlag&& other) noexcept = default;
+    ~DestructionFlag() {
+        if (destroyed) {
+            *destroyed = true;
+        }
+    }
+
+    std::shared_ptr<bool> destroyed;
+};
+
+// `tracker` is never read; it exists only so the coroutine frame owns the flag.
+Task<int> ReturnWithTracker([[maybe_unused]] DestructionFlag tracker, int value) {
+    co_return value;
+}
+
+Task<int> AddOne(int value) {
+    co_return value + 1;
+}
+
+Task<int> AwaitNested() {
+    const int first = co_await AddOne(1);
+    const int second = co_await AddOne(first);
+    co_return second;
+}
+
+} // namespace
+
+TEST(FrameAllocator, ReusesBlocksOnTheSameThread) {
+    void* first = allocate_frame(200);
+    deallocate_frame(first, 200);
+
+    void* second = allocate_frame(180);
+    EXPECT_EQ(first, second);
+    deallocate_frame(second, 180);
+}
+
+TEST(FrameAllocator, AcceptsBlocksReleasedOnOtherThreads) {
+    constexpr std::size_t kBlocks = 256;
+    std::vector<void*> blocks;
+    std::thread producer([&]() {
+        for (std::size_t i = 0; i < kBlocks; ++i) {
+            blocks.push_back(allocate_frame(96));
+        }
+    });
+    producer.join();
+
+    for (void* block : blocks) {
+        ASSERT_NE(block, nullptr);
+        deallocate_frame(block, 96);
+    }
+}
+
+TEST(FrameAllocator, FallsBackToOperatorNewForLargeFrames) {
+    void* block = allocate_frame(64 * 1024);
+    ASSERT_NE(block, nullptr);
+    deallocate_frame(block, 64 * 1024);
+}
+
+TEST(FrameAllocator, CoroutineFrameIsDestroyedWhenTaskIsReleased) {
+    auto destroyed = std::make_shared<bool>(false);
+    {
+        auto task = ReturnWithTracker(DestructionFlag{destroyed}, 5);
+        EXPECT_EQ(task.get(), 5);
+        EXPECT_FALSE(*destroyed);
+    }
+    EXPECT_TRUE(*destroyed);
+}
+
+TEST(FrameAllocator, UnstartedCoroutineFrameIsDestroyed) {
+    auto destroyed = std::make_shared<bool>(false);
+    {
+        auto task = ReturnWithTracker(DestructionFlag{destroyed}, 5);
+    }
+    EXPECT_TRUE(*destroyed);
+}
+
+TEST(FrameAllocator, NestedAwaitsCompleteWithPooledFrames) {
+    EXPECT_EQ(AwaitNested().get(), 3);
+}
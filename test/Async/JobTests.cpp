@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <utility>
+
+#include "Async/Job.h"
+
+using soul::async::detail::Job;
+using soul::async::detail::JobStoragePool;
+
+TEST(Job, InvokesInlineCallableAndReleasesCaptures) {
+    JobStoragePool pool;
+    auto counter = std::make_shared<int>(0);
+
+    Job job([counter]() { ++*counter; }, pool);
+    EXPECT_TRUE(job);
+    EXPECT_EQ(counter.use_count(), 2);
+
+    job();
+    EXPECT_EQ(*counter, 1);
+
+    job.reset();
+    EXPECT_FALSE(job);
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(Job, BoxesOversizedCallablesAndMovesOwnership) {
+    JobStoragePool pool;
+    auto counter = std::make_shared<int>(0);
+    std::array<char, Job::kInlineSize * 2> payload{};
+    payload[0] = 7;
+
+    Job first([counter, payload]() { *counter += payload[0]; }, pool);
+    Job second(std::move(first));
+    EXPECT_FALSE(first);
+    ASSERT_TRUE(second);
+
+    second();
+    EXPECT_EQ(*counter, 7);
+
+    Job third;
+    third = std::move(second);
+    third();
+    EXPECT_EQ(*counter, 14);
+    EXPECT_EQ(counter.use_count(), 2);
+
+    third = Job{};
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(Job, AcceptsMoveOnlyCallables) {
+    JobStoragePool pool;
+    auto value = std::make_unique<int>(41);
+    int observed = 0;
+
+    Job job([value = std::move(value), &observed]() mutable { observed = ++*value; }, pool);
+    Job moved(std::move(job));
+    moved();
+    EXPECT_EQ(observed, 42);
+}
+
+TEST(JobStoragePool, RecyclesBlocks) {
+    JobStoragePool pool;
+    void* first = pool.allocate(64, alignof(std::max_align_t));
+    pool.deallocate(first, 64, alignof(std::max_align_t));
+    void* second = pool.allocate(128, alignof(std::max_align_t));
+    EXPECT_EQ(first, second);
+    pool.deallocate(second, 128, alignof(std::max_align_t));
+
+    void* large = pool.allocate(JobStoragePool::kBlockSize * 4, alignof(std::max_align_t));
+    ASSERT_NE(large, nullptr);
+    pool.deallocate(large, JobStoragePool::kBlockSize * 4, alignof(std::max_align_t));
+}
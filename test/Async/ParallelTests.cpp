@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Async/Parallel.h"
+
+namespace parallel = soul::async::parallel;
+
+namespace {
+
+std::vector<int> RandomValues(std::size_t count, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-1000000, 1000000);
+    std::vector<int> values(count);
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(Parallel, ForVisitsEveryIndexExactlyOnce) {
+    soul::async::TaskScheduler scheduler(4);
+    std::vector<std::atomic_int> hits(100000);
+
+    parallel::parallel_for(scheduler, 0, hits.size(), [&hits](std::size_t index) {
+        hits[index].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](const std::atomic_int& hit) { return hit.load() == 1; }));
+}
+
+TEST(Parallel, ForAcceptsRangeBodiesAndOffsets) {
+    soul::async::TaskScheduler scheduler(2);
+    std::vector<int> values(5000, 0);
+
+    parallel::parallel_for(scheduler, 1000, 4000, [&values](std::size_t begin, std::size_t end) {
+        for (auto index = begin; index < end; ++index) {
+            values[index] = 1;
+        }
+    });
+
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 3000);
+    EXPECT_EQ(values[999], 0);
+    EXPECT_EQ(values[1000], 1);
+    EXPECT_EQ(values[3999], 1);
+    EXPECT_EQ(values[4000], 0);
+}
+
+TEST(Parallel, NestedLoopsOnASingleWorkerDoNotDeadlock) {
+    soul::async::TaskScheduler scheduler(1);
+    std::atomic_int total{0};
+
+    scheduler.run_async([&]() {
+        parallel::parallel_for(scheduler, 0, 64, [&](std::size_t) {
+            parallel::parallel_for(scheduler, 0, 64, [&](std::size_t) { total.fetch_add(1); });
+        }, soul::async::ParallelOptions{1});
+    }).get();
+
+    EXPECT_EQ(total.load(), 64 * 64);
+}
+
+TEST(Parallel, ReduceMatchesSequentialSum) {
+    soul::async::TaskScheduler scheduler(4);
+    std::vector<std::int64_t> values(250000);
+    std::iota(values.begin(), values.end(), 1);
+
+    const auto sum = parallel::parallel_reduce(scheduler, values.begin(), values.end(), std::int64_t{7});
+    EXPECT_EQ(sum, std::int64_t{7} + std::int64_t{250000} * 250001 / 2);
+
+    const auto empty = parallel::parallel_reduce(scheduler, values.begin(), values.begin(), std::int64_t{7});
+    EXPECT_EQ(empty, 7);
+
+    const auto largest = parallel::parallel_reduce(scheduler, values.begin(), values.end(), std::int64_t{0},
+                                                   [](std::int64_t a, std::int64_t b) { return std::max(a, b); });
+    EXPECT_EQ(largest, 250000);
+}
+
+TEST(Parallel, TransformWritesEveryOutput) {
+    soul::async::TaskScheduler scheduler(4);
+    const auto input = RandomValues(50000, 1);
+    std::vector<std::int64_t> output(input.size());
+
+    const auto end = parallel::parallel_transform(scheduler, input.begin(), input.end(), output.begin(),
+                                                  [](int value) { return std::int64_t{value} * 3; });
+
+    EXPECT_EQ(end, output.end());
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        ASSERT_EQ(output[i], std::int64_t{input[i]} * 3);
+    }
+}
+
+TEST(Parallel, SortMatchesStdSort) {
+    soul::async::TaskScheduler scheduler(4);
+    for (std::size_t count : {0u, 1u, 100u, 8191u, 100000u, 123457u}) {
+        auto values = RandomValues(count, static_cast<std::uint32_t>(count));
+        auto expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+
+        parallel::parallel_sort(scheduler, values.begin(), values.end(), std::greater<>());
+        EXPECT_EQ(values, expected) << "count " << count;
+    }
+}
+
+TEST(Parallel, StableSortKeepsEqualKeysInOrder) {
+    soul::async::TaskScheduler scheduler(4);
+    std::vector<std::pair<int, int>> values(60000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = {static_cast<int>((i * 7919) % 97), static_cast<int>(i)};
+    }
+
+    parallel::parallel_stable_sort(scheduler, values.begin(), values.end(),
+                                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(Parallel, ExceptionsPropagateToTheCaller) {
+    soul::async::TaskScheduler scheduler(4);
+    std::atomic_int visited{0};
+
+    EXPECT_THROW(parallel::parallel_for(scheduler, 0, 100000, [&visited](std::size_t index) {
+        visited.fetch_add(1, std::memory_order_relaxed);
+        if (index == 500) {
+            throw std::runtime_error("boom");
+        }
+    }), std::runtime_error);
+
+    // The loop stops handing out work once a chunk has thrown.
+    EXPECT_LT(visited.load(), 100000);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "Async/SchedulerMetrics.h"
+#include "Async/Task.h"
+
+using namespace std::chrono_literals;
+
+TEST(SchedulerMetrics, HistogramBucketsAreLog2) {
+    using soul::async::HistogramSnapshot;
+    EXPECT_EQ(HistogramSnapshot::bucket_for(0ns), 0u);
+    EXPECT_EQ(HistogramSnapshot::bucket_for(255ns), 0u);
+    EXPECT_EQ(HistogramSnapshot::bucket_for(256ns), 1u);
+    EXPECT_EQ(HistogramSnapshot::bucket_for(511ns), 1u);
+    EXPECT_EQ(HistogramSnapshot::bucket_for(512ns), 2u);
+    EXPECT_EQ(HistogramSnapshot::bucket_for(1h), HistogramSnapshot::kBuckets - 1);
+    EXPECT_EQ(HistogramSnapshot::bucket_upper_bound(0), 256ns);
+    EXPECT_EQ(HistogramSnapshot::bucket_upper_bound(1), 512ns);
+
+    soul::async::detail::LatencyHistogram histogram;
+    for (int i = 0; i < 98; ++i) {
+        histogram.record(100ns);
+    }
+    histogram.record(3us);
+    histogram.record(3us);
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 100u);
+    EXPECT_EQ(snapshot.total, 98 * 100ns + 6us);
+    EXPECT_EQ(snapshot.percentile(0.5), 256ns);
+    EXPECT_EQ(snapshot.percentile(0.99), 4096ns);
+    EXPECT_EQ(HistogramSnapshot{}.percentile(0.5), 0ns);
+}
+
+TEST(SchedulerMetrics, SnapshotReportsWorkersAndCounters) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    constexpr int kJobs = 64;
+
+    std::vector<soul::async::Task<int>> tasks;
+    for (int i = 0; i < kJobs; ++i) {
+        tasks.push_back(scheduler->run_async([i] { return i; }));
+    }
+    for (auto& task : tasks) {
+        task.get();
+    }
+
+    const auto metrics = scheduler->metrics();
+    ASSERT_EQ(metrics.workers.size(), 2u);
+    EXPECT_EQ(metrics.enabled, SOULLIB_SCHEDULER_METRICS != 0);
+#if SOULLIB_SCHEDULER_METRICS
+    // The last job may still be accounting for itself when its result is published.
+    EXPECT_GE(metrics.jobs_executed(), kJobs - 1u);
+    EXPECT_GE(metrics.queue_latency().count, metrics.jobs_executed());
+    EXPECT_GE(metrics.execution_time().count, kJobs - 1u);
+#else
+    EXPECT_EQ(metrics.jobs_executed(), 0u);
+    EXPECT_EQ(metrics.queue_latency().count, 0u);
+#endif
+
+    scheduler->stop();
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Async/SchedulerOptions.h"
+#include "Async/Task.h"
+
+TEST(SchedulerOptions, TopologyListsEveryCpuOnce) {
+    const auto nodes = soul::async::numa_topology();
+    ASSERT_FALSE(nodes.empty());
+    std::set<std::uint32_t> cpus;
+    for (const auto& node : nodes) {
+        EXPECT_FALSE(node.cpus.empty());
+        for (const auto cpu : node.cpus) {
+            EXPECT_TRUE(cpus.insert(cpu).second) << "cpu " << cpu << " listed twice";
+        }
+    }
+}
+
+TEST(SchedulerOptions, PinnedWorkersRunOnTheirCpuSet) {
+    const auto cpu = soul::async::current_cpu();
+    if (!cpu) {
+        GTEST_SKIP() << "the platform does not report the current CPU";
+    }
+
+    soul::async::SchedulerOptions options;
+    options.workerCount = 2;
+    options.cpuSets = {{*cpu}};
+    soul::async::TaskScheduler scheduler(options);
+
+    std::vector<soul::async::Task<std::uint32_t>> tasks;
+    for (int i = 0; i < 32; ++i) {
+        tasks.push_back(scheduler.run_async([]() {
+            return soul::async::current_cpu().value_or(~0u);
+        }));
+    }
+    for (auto& task : tasks) {
+        EXPECT_EQ(task.get(), *cpu);
+    }
+}
+
+TEST(SchedulerOptions, NumaAwareSchedulerGroupsEveryWorker) {
+    soul::async::SchedulerOptions options;
+    options.workerCount = 3;
+    options.numaAware = true;
+    soul::async::TaskScheduler scheduler(options);
+
+    const auto nodes = soul::async::numa_topology();
+    EXPECT_EQ(scheduler.worker_group_count(), std::min<std::size_t>(nodes.size(), 3));
+    std::atomic_int sum{0};
+    std::vector<soul::async::Task<void>> tasks;
+    for (int i = 1; i <= 100; ++i) {
+        tasks.push_back(scheduler.run_async([&sum, i]() { sum += i; }));
+    }
+    for (auto& task : tasks) {
+        task.get();
+    }
+    EXPECT_EQ(sum.load(), 5050);
+    for (const auto& worker : scheduler.metrics().workers) {
+        EXPECT_LT(worker.group, scheduler.worker_group_count());
+    }
+}
+
+TEST(SchedulerOptions, IoJobsRunOnIoWorkersAndResumeOnComputeWorkers) {
+    soul::async::SchedulerOptions options;
+    options.workerCount = 1;
+    options.ioWorkerCount = 1;
+    soul::async::TaskScheduler scheduler(options);
+    EXPECT_EQ(scheduler.io_worker_count(), 1u);
+
+    auto probe = scheduler.run_async([]() { return std::this_thread::get_id(); });
+    const auto computeThread = probe.get();
+
+    std::thread::id ioThread;
+    std::thread::id resumedOn;
+    auto awaitIo = [&]() -> soul::async::Task<int> {
+        auto io = scheduler.run_io([&]() {
+            ioThread = std::this_thread::get_id();
+            return 42;
+        });
+        const auto value = co_await io;
+        resumedOn = std::this_thread::get_id();
+        co_return value;
+    };
+    auto task = scheduler.schedule(awaitIo());
+    EXPECT_EQ(task.get(), 42);
+    EXPECT_NE(ioThread, computeThread);
+    EXPECT_NE(ioThread, std::this_thread::get_id());
+    EXPECT_EQ(resumedOn, computeThread);
+
+    soul::async::CancellationSource source;
+    source.cancel();
+    auto cancelled = scheduler.run_io(source.token(), []() { return 1; });
+    EXPECT_THROW(cancelled.get(), soul::async::OperationCancelled);
+}
+
+TEST(SchedulerOptions, ParkingPolicyIsResolvedAndEveryPolicyDrainsWork) {
+    soul::async::SchedulerOptions options;
+    options.workerCount = 4;
+    {
+        soul::async::TaskScheduler scheduler(options);
+        EXPECT_EQ(scheduler.parking_policy().maxSpinningWorkers, 2u);
+        EXPECT_EQ(scheduler.parking_policy().yieldRounds, options.parking.yieldRounds);
+        if (std::thread::hardware_concurrency() <= 1) {
+            EXPECT_EQ(scheduler.parking_policy().spinRounds, 0u);
+        }
+    }
+
+    for (const std::uint32_t rounds : {0u, 1000u}) {
+        options.parking.spinRounds = rounds;
+        options.parking.yieldRounds = rounds;
+        options.parking.maxSpinningWorkers = 1;
+        soul::async::TaskScheduler scheduler(options);
+
+        // Bursts separated by idle gaps make workers go through the poll/park path repeatedly.
+        std::atomic_int sum{0};
+        for (int burst = 0; burst < 20; ++burst) {
+            std::vector<soul::async::Task<void>> tasks;
+            for (int i = 1; i <= 50; ++i) {
+                tasks.push_back(scheduler.run_async([&sum, i]() { sum.fetch_add(i); }));
+            }
+            for (auto& task : tasks) {
+                task.get();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        EXPECT_EQ(sum.load(), 20 * 1275) << "rounds " << rounds;
+    }
+}
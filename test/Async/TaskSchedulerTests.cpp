@@ -0,0 +1,549 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Async/Task.h"
+#include "Async/WorkStealingDeque.h"
+
+namespace {
+
+void SpawnTree(soul::async::TaskScheduler& scheduler, std::atomic<int>& visited, int depth) {
+    visited.fetch_add(1, std::memory_order_relaxed);
+    if (depth == 0) {
+        return;
+    }
+    for (int i = 0; i < 2; ++i) {
+        scheduler.run_async([&scheduler, &visited, depth]() {
+            SpawnTree(scheduler, visited, depth - 1);
+        });
+    }
+}
+
+soul::async::Task<int> CountDown(int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await CountDown(depth - 1);
+}
+
+soul::async::Task<std::thread::id> ThreadAfterAwaiting(const soul::async::Task<void>& task) {
+    co_await task;
+    co_return std::this_thread::get_id();
+}
+
+} // namespace
+
+TEST(WorkStealingDeque, OwnerPopsLifoAndThievesStealFifo) {
+    soul::async::detail::WorkStealingDeque<int> deque(2);
+    for (int i = 0; i < 8; ++i) {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), 8u);
+
+    EXPECT_EQ(deque.pop(), 7);
+    EXPECT_EQ(deque.steal(), 0);
+    EXPECT_EQ(deque.steal(), 1);
+    EXPECT_EQ(deque.pop(), 6);
+    EXPECT_EQ(deque.size(), 4u);
+}
+
+TEST(WorkStealingDeque, ConcurrentStealsConsumeEachItemOnce) {
+    constexpr int kItems = 20000;
+    soul::async::detail::WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int>> seen(kItems);
+    std::atomic<bool> producing{true};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&]() {
+            while (producing.load(std::memory_order_acquire) || !deque.empty()) {
+                if (auto item = deque.steal()) {
+                    seen[*item].fetch_add(1, std::memory_order_relaxed);
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < kItems; ++i) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (auto item = deque.pop()) {
+                seen[*item].fetch_add(1, std::memory_order_relaxed);
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    while (auto item = deque.pop()) {
+        seen[*item].fetch_add(1, std::memory_order_relaxed);
+        consumed.fetch_add(1, std::memory_order_relaxed);
+    }
+    producing.store(false, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    EXPECT_EQ(consumed.load(), kItems);
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](const auto& count) { return count.load() == 1; }));
+}
+
+TEST(TaskScheduler, RunAsyncFromExternalThreads) {
+    soul::async::TaskScheduler scheduler(4);
+
+    std::vector<std::future<int>> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back(std::async(std::launch::async, [&scheduler, p]() {
+            int sum = 0;
+            for (int i = 0; i < 100; ++i) {
+                sum += scheduler.run_async([p, i]() { return p * 1000 + i; }).get();
+            }
+            return sum;
+        }));
+    }
+
+    for (int p = 0; p < 4; ++p) {
+        EXPECT_EQ(producers[p].get(), p * 1000 * 100 + 4950);
+    }
+}
+
+TEST(TaskScheduler, JobsSpawnedFromWorkersAreStolenAndCompleted) {
+    soul::async::TaskScheduler scheduler(4);
+    std::atomic<int> visited{0};
+    constexpr int kDepth = 10;
+    constexpr int kExpected = (1 << (kDepth + 1)) - 1;
+
+    scheduler.run_async([&]() { SpawnTree(scheduler, visited, kDepth); });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (visited.load(std::memory_order_acquire) < kExpected &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(visited.load(), kExpected);
+}
+
+TEST(TaskScheduler, DeepAwaitChainsCompleteInline) {
+    // Each level transfers into its child and is resumed from the child's final suspend.
+    constexpr int kDepth = 2000;
+    EXPECT_EQ(CountDown(kDepth).get(), kDepth);
+}
+
+TEST(TaskScheduler, RunAsyncResumesAwaiterOnTheCompletingWorker) {
+    soul::async::TaskScheduler scheduler(2);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    std::thread::id jobThread;
+    auto job = scheduler.run_async([&jobThread, gate]() {
+        gate.wait();
+        jobThread = std::this_thread::get_id();
+    });
+
+    // Hold the job back until the awaiter has parked, so it cannot observe an already-finished task.
+    auto releaser = std::async(std::launch::async, [&job, &release]() {
+        while (job.state()->continuations.load(std::memory_order_acquire) == nullptr) {
+            std::this_thread::yield();
+        }
+        release.set_value();
+    });
+
+    const auto resumedOn = ThreadAfterAwaiting(job).get();
+    releaser.get();
+    EXPECT_EQ(resumedOn, jobThread);
+    EXPECT_NE(resumedOn, std::this_thread::get_id());
+}
+
+TEST(TaskScheduler, AwaitingScheduledTaskDoesNotStartItTwice) {
+    soul::async::TaskScheduler scheduler(2);
+    std::atomic<int> starts{0};
+    auto producer = scheduler.schedule([](std::atomic<int>& counter) -> soul::async::Task<int> {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        co_return 7;
+    }(starts));
+
+    auto consumer = [](soul::async::Task<int>& task) -> soul::async::Task<int> {
+        co_return co_await task;
+    };
+    EXPECT_EQ(consumer(producer).get(), 7);
+    EXPECT_EQ(starts.load(), 1);
+}
+
+TEST(TaskScheduler, CompletionResumesEveryAwaiter) {
+    soul::async::TaskScheduler scheduler(4);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    auto producer = scheduler.run_async([gate]() { gate.wait(); });
+
+    std::atomic<int> resumed{0};
+    auto consumer = [](const soul::async::Task<void>& task, std::atomic<int>& counter) -> soul::async::Task<void> {
+        co_await task;
+        counter.fetch_add(1, std::memory_order_relaxed);
+    };
+    std::vector<soul::async::Task<void>> consumers;
+    for (int i = 0; i < 8; ++i) {
+        consumers.push_back(scheduler.schedule(consumer(producer, resumed)));
+    }
+
+    release.set_value();
+    for (auto& task : consumers) {
+        task.get();
+    }
+    EXPECT_EQ(resumed.load(), 8);
+}
+
+TEST(TaskScheduler, BlockingWaitersOnOneTaskAllWake) {
+    soul::async::TaskScheduler scheduler(2);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    auto task = scheduler.run_async([gate]() { gate.wait(); });
+    const auto token = task.token();
+
+    std::vector<std::future<void>> waiters;
+    for (int i = 0; i < 4; ++i) {
+        waiters.emplace_back(std::async(std::launch::async, [&scheduler, token]() { scheduler.wait(token); }));
+    }
+    release.set_value();
+    for (auto& waiter : waiters) {
+        EXPECT_EQ(waiter.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    }
+}
+
+TEST(TaskScheduler, DependentRunsWhenDependencyIsDroppedUnstarted) {
+    soul::async::TaskScheduler scheduler(2);
+    std::promise<void> ran;
+    auto ranFuture = ran.get_future();
+
+    auto body = [](std::promise<void>& signal) -> soul::async::Task<void> {
+        signal.set_value();
+        co_return;
+    };
+    {
+        auto never = []() -> soul::async::Task<void> { co_return; }();
+        const std::array<soul::async::TaskToken, 1> dependencies{never.token()};
+        // The dependent's handle is dropped immediately; the scheduler keeps it alive.
+        scheduler.schedule(body(ran), dependencies);
+    }
+    EXPECT_EQ(ranFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST(TaskScheduler, TaskStateStaysCompact) {
+    // One atomic word replaces the former mutex, condition variable and continuation vectors.
+    EXPECT_LE(sizeof(soul::async::detail::TaskStateBase), 96u);
+}
+
+TEST(TaskScheduler, HighPriorityJobsOvertakeQueuedLowWork) {
+    soul::async::TaskScheduler scheduler(1);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    auto blocker = scheduler.run_async([gate]() { gate.wait(); });
+
+    std::mutex orderMutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        std::lock_guard lock(orderMutex);
+        order.push_back(id);
+    };
+
+    std::vector<soul::async::Task<void>> tasks;
+    for (int i = 0; i < 4; ++i) {
+        tasks.push_back(scheduler.run_async(soul::async::TaskPriority::Low, [&record]() { record(0); }));
+    }
+    tasks.push_back(scheduler.run_async(soul::async::TaskPriority::Normal, [&record]() { record(1); }));
+    tasks.push_back(scheduler.run_async(soul::async::TaskPriority::High, [&record]() { record(2); }));
+
+    release.set_value();
+    blocker.get();
+    for (auto& task : tasks) {
+        task.get();
+    }
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 0, 0, 0, 0}));
+}
+
+TEST(TaskScheduler, LocalDequesDrainHigherLanesFirst) {
+    soul::async::TaskScheduler scheduler(1);
+    std::vector<int> order;
+
+    // Spawned from the worker itself, so every job lands in that worker's local deques.
+    scheduler.run_async([&]() {
+        scheduler.run_async(soul::async::TaskPriority::Low, [&order]() { order.push_back(0); });
+        scheduler.run_async(soul::async::TaskPriority::High, [&order]() { order.push_back(2); });
+        scheduler.run_async(soul::async::TaskPriority::Normal, [&order]() { order.push_back(1); });
+    }).get();
+
+    scheduler.run_async(soul::async::TaskPriority::Low, []() {}).get();
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 0}));
+}
+
+TEST(TaskScheduler, ApproachingDeadlinePromotesLowWork) {
+    soul::async::TaskScheduler scheduler(1);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    auto blocker = scheduler.run_async([gate]() { gate.wait(); });
+
+    std::mutex orderMutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        std::lock_guard lock(orderMutex);
+        order.push_back(id);
+    };
+
+    const auto now = soul::async::TaskScheduler::Clock::now();
+    std::vector<soul::async::Task<void>> tasks;
+    tasks.push_back(scheduler.run_async(soul::async::TaskPriority::Normal, [&record]() { record(1); }));
+    tasks.push_back(scheduler.run_async(soul::async::TaskPriority::Low, now + std::chrono::hours(1),
+                                        [&record]() { record(0); }));
+    tasks.push_back(scheduler.run_async(soul::async::TaskPriority::Low, now, [&record]() { record(2); }));
+
+    release.set_value();
+    blocker.get();
+    for (auto& task : tasks) {
+        task.get();
+    }
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 0}));
+}
+
+namespace {
+
+soul::async::Task<void> SleepThenRecord(soul::async::TaskScheduler& scheduler,
+                                        std::chrono::milliseconds delay,
+                                        std::mutex& orderMutex,
+                                        std::vector<int>& order,
+                                        int id) {
+    co_await scheduler.sleep_for(delay);
+    std::lock_guard lock(orderMutex);
+    order.push_back(id);
+}
+
+} // namespace
+
+TEST(TaskScheduler, SleepForResumesAfterTheDelay) {
+    soul::async::TaskScheduler scheduler(1);
+    const auto start = soul::async::TaskScheduler::Clock::now();
+
+    auto sleeper = [&]() -> soul::async::Task<std::chrono::steady_clock::duration> {
+        co_await scheduler.sleep_for(std::chrono::milliseconds(20));
+        co_return soul::async::TaskScheduler::Clock::now() - start;
+    };
+
+    EXPECT_GE(scheduler.schedule(sleeper()).get(), std::chrono::milliseconds(20));
+}
+
+TEST(TaskScheduler, SleepersDoNotHoldWorkers) {
+    soul::async::TaskScheduler scheduler(1);
+    std::mutex orderMutex;
+    std::vector<int> order;
+
+    // A hundred sleepers on one worker: each would block the pool if sleeping took a thread.
+    std::vector<soul::async::Task<void>> tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.push_back(scheduler.schedule(SleepThenRecord(scheduler, std::chrono::milliseconds(30), orderMutex, order, 1)));
+    }
+    tasks.push_back(scheduler.schedule(SleepThenRecord(scheduler, std::chrono::milliseconds(5), orderMutex, order, 0)));
+
+    const auto start = soul::async::TaskScheduler::Clock::now();
+    for (auto& task : tasks) {
+        task.get();
+    }
+    EXPECT_LT(soul::async::TaskScheduler::Clock::now() - start, std::chrono::seconds(1));
+    ASSERT_EQ(order.size(), 101u);
+    EXPECT_EQ(order.front(), 0);
+}
+
+TEST(TaskScheduler, ScheduleAtWaitsForTimeAndDependencies) {
+    soul::async::TaskScheduler scheduler(2);
+    using Clock = soul::async::TaskScheduler::Clock;
+
+    std::atomic_bool dependencyDone{false};
+    auto dependency = scheduler.run_async([&dependencyDone]() { dependencyDone.store(true); });
+    const std::array<soul::async::TaskToken, 1> deps{dependency.token()};
+
+    const auto startTime = Clock::now() + std::chrono::milliseconds(15);
+    auto body = [&]() -> soul::async::Task<bool> {
+        co_return Clock::now() >= startTime && dependencyDone.load();
+    };
+
+    auto task = scheduler.schedule_at(startTime, body(), soul::async::TaskPriority::High, deps);
+    EXPECT_TRUE(task.get());
+}
+
+TEST(TaskScheduler, ExposesTheCurrentSchedulerAndWorker) {
+    soul::async::TaskScheduler scheduler(2);
+    EXPECT_EQ(soul::async::current_scheduler(), nullptr);
+    EXPECT_FALSE(soul::async::current_worker().has_value());
+    EXPECT_FALSE(scheduler.owns_current_thread());
+
+    auto probe = scheduler.run_async([&scheduler]() {
+        const auto worker = soul::async::current_worker();
+        return soul::async::current_scheduler() == &scheduler && scheduler.owns_current_thread() &&
+               worker && *worker < scheduler.worker_count();
+    });
+    EXPECT_TRUE(probe.get());
+}
+
+TEST(TaskScheduler, ScheduleOnHopsOnceAndThenCompletesInline) {
+    soul::async::TaskScheduler scheduler(1);
+    const auto caller = std::this_thread::get_id();
+
+    auto body = [&]() -> soul::async::Task<bool> {
+        auto hop = scheduler.schedule_on();
+        co_await hop;
+        const auto worker = std::this_thread::get_id();
+        // Already on the pool: this one must not suspend.
+        auto again = scheduler.schedule_on(soul::async::TaskPriority::High);
+        const bool completedInline = again.await_ready();
+        co_await again;
+        co_return worker != caller && std::this_thread::get_id() == worker && completedInline &&
+            soul::async::current_scheduler() == &scheduler;
+    };
+    // Started inline on this thread by get().
+    EXPECT_TRUE(body().get());
+}
+
+TEST(TaskScheduler, YieldLetsQueuedWorkRunFirst) {
+    soul::async::TaskScheduler scheduler(1);
+
+    auto body = [&]() -> soul::async::Task<bool> {
+        std::atomic_bool ran{false};
+        auto queued = scheduler.run_async([&ran]() { ran.store(true); });
+        auto yielding = scheduler.yield();
+        co_await yielding;
+        co_return ran.load();
+    };
+    auto task = scheduler.schedule(body());
+    EXPECT_TRUE(task.get());
+}
+
+TEST(TaskScheduler, ScheduleBatchStartsEveryTaskOnce) {
+    soul::async::TaskScheduler scheduler(4);
+    std::atomic_int runs{0};
+    auto body = [&](int value) -> soul::async::Task<int> {
+        runs.fetch_add(1, std::memory_order_relaxed);
+        co_return value * 2;
+    };
+
+    std::vector<soul::async::Task<int>> tasks;
+    for (int i = 0; i < 1000; ++i) {
+        tasks.push_back(body(i));
+    }
+    tasks.emplace_back();
+    scheduler.schedule_batch(std::span(tasks), soul::async::TaskPriority::High);
+    // Already started: a second batch must not run anything again.
+    scheduler.schedule_batch(std::span(tasks));
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(tasks[i].get(), i * 2);
+    }
+    EXPECT_EQ(runs.load(), 1000);
+
+    // From a worker thread the batch lands on that worker's deque and is stolen from there.
+    auto nested = [&]() -> soul::async::Task<int> {
+        std::vector<soul::async::Task<int>> inner;
+        for (int i = 0; i < 100; ++i) {
+            inner.push_back(body(i));
+        }
+        scheduler.schedule_batch(std::span(inner));
+        int sum = 0;
+        for (auto& task : inner) {
+            sum += co_await task;
+        }
+        co_return sum;
+    };
+    EXPECT_EQ(scheduler.schedule(nested()).get(), 9900);
+}
+
+TEST(TaskScheduler, RunAsyncBulkKeepsResultsAndErrorsPerIndex) {
+    soul::async::TaskScheduler scheduler(4);
+    auto tasks = scheduler.run_async_bulk(500, [](std::size_t index) {
+        if (index == 7) {
+            throw std::runtime_error("item 7");
+        }
+        return index * index;
+    });
+    ASSERT_EQ(tasks.size(), 500u);
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        if (i == 7) {
+            EXPECT_THROW(tasks[i].get(), std::runtime_error);
+        } else {
+            EXPECT_EQ(tasks[i].get(), i * i);
+        }
+    }
+
+    std::atomic_size_t visited{0};
+    auto updates = scheduler.run_async_bulk(64, [&visited](std::size_t) {
+        visited.fetch_add(1, std::memory_order_relaxed);
+    });
+    for (auto& update : updates) {
+        update.get();
+    }
+    EXPECT_EQ(visited.load(), 64u);
+    EXPECT_TRUE(scheduler.run_async_bulk(0, [](std::size_t) {}).empty());
+}
+
+TEST(TaskScheduler, DestructionDiscardsQueuedJobsWhileTheSchedulerIsAlive) {
+    struct SubmitOnDestroy {
+        soul::async::TaskScheduler* scheduler;
+        std::atomic_bool* destroyed;
+        SubmitOnDestroy(soul::async::TaskScheduler* owner, std::atomic_bool* flag) : scheduler(owner), destroyed(flag) {}
+        SubmitOnDestroy(SubmitOnDestroy&& other) noexcept
+            : scheduler(std::exchange(other.scheduler, nullptr)), destroyed(other.destroyed) {}
+        ~SubmitOnDestroy() {
+            if (scheduler) {
+                // Dropped: the scheduler has stopped, but its queues are still intact.
+                (void)scheduler->run_async([]() {});
+                destroyed->store(true);
+            }
+        }
+    };
+
+    std::atomic_bool destroyed{false};
+    std::atomic_bool ran{false};
+    {
+        soul::async::TaskScheduler scheduler(1);
+        std::promise<void> started;
+        (void)scheduler.run_async([&started]() {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+        started.get_future().wait();
+        (void)scheduler.run_async([&ran, guard = SubmitOnDestroy(&scheduler, &destroyed)]() {
+            ran = true;
+        });
+    }
+    EXPECT_FALSE(ran.load());
+    EXPECT_TRUE(destroyed.load());
+}
+
+TEST(TaskScheduler, DestructionDropsQueuedDependencyChains) {
+    std::atomic_bool dependentRan{false};
+    auto body = [](std::atomic_bool& ran) -> soul::async::Task<void> {
+        ran = true;
+        co_return;
+    };
+    {
+        soul::async::TaskScheduler scheduler(1);
+        std::promise<void> started;
+        (void)scheduler.run_async([&started]() {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+        started.get_future().wait();
+        {
+            // Only the queued job keeps the dependency alive; discarding it releases the dependent
+            // from the dependency's destructor while the scheduler is shutting down.
+            auto dependency = scheduler.run_async([]() { return 1; });
+            const std::array<soul::async::TaskToken, 1> dependencies{dependency.token()};
+            scheduler.schedule(body(dependentRan), dependencies);
+        }
+    }
+    EXPECT_FALSE(dependentRan.load());
+}
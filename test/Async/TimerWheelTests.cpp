@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Async/TimerWheel.h"
+
+namespace {
+
+using soul::async::detail::TimerNode;
+using soul::async::detail::TimerWheel;
+
+std::vector<std::uint64_t> DueTicks(TimerNode* list) {
+    std::vector<std::uint64_t> ticks;
+    for (; list; list = list->next) {
+        ticks.push_back(list->dueTick);
+    }
+    std::sort(ticks.begin(), ticks.end());
+    return ticks;
+}
+
+} // namespace
+
+TEST(TimerWheel, ExpiresTimersOnTheirTick) {
+    TimerWheel wheel;
+    TimerNode near{};
+    near.dueTick = 5;
+    TimerNode far{};
+    far.dueTick = 9;
+    wheel.insert(&near);
+    wheel.insert(&far);
+
+    EXPECT_EQ(wheel.advance(4), nullptr);
+    EXPECT_EQ(DueTicks(wheel.advance(5)), (std::vector<std::uint64_t>{5}));
+    EXPECT_EQ(wheel.advance(8), nullptr);
+    EXPECT_EQ(DueTicks(wheel.advance(9)), (std::vector<std::uint64_t>{9}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, AlreadyDueTimersExpireOnNextAdvance) {
+    TimerWheel wheel(100);
+    TimerNode node{};
+    node.dueTick = 50;
+    wheel.insert(&node);
+
+    EXPECT_EQ(wheel.next_event_tick(), 100u);
+    EXPECT_EQ(wheel.advance(100), &node);
+}
+
+TEST(TimerWheel, CascadesAcrossEveryLevelWithoutFiringEarly) {
+    TimerWheel wheel(7);
+    // Deltas that land on each level, plus one past the wheel's direct horizon (64^4 ticks).
+    std::vector<std::uint64_t> dueTicks{8, 70, 64 + 4096 + 3, 300000, 17000000, 20000000};
+    std::vector<TimerNode> nodes(dueTicks.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].dueTick = dueTicks[i];
+        wheel.insert(&nodes[i]);
+    }
+
+    std::vector<std::uint64_t> fired;
+    while (!wheel.empty()) {
+        const auto next = wheel.next_event_tick();
+        ASSERT_TRUE(next.has_value());
+        for (auto* node = wheel.advance(*next); node; node = node->next) {
+            EXPECT_EQ(node->dueTick, wheel.current_tick());
+            fired.push_back(node->dueTick);
+        }
+    }
+    EXPECT_EQ(fired, dueTicks);
+}
+
+TEST(TimerWheel, LargeAdvanceCollectsEverythingDue) {
+    TimerWheel wheel;
+    std::vector<TimerNode> nodes(200);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].dueTick = 1 + i * 97;
+        wheel.insert(&nodes[i]);
+    }
+
+    const auto expired = DueTicks(wheel.advance(10000));
+    EXPECT_EQ(expired.size(), 104u);
+    EXPECT_TRUE(std::all_of(expired.begin(), expired.end(), [](std::uint64_t tick) { return tick <= 10000; }));
+    EXPECT_EQ(wheel.size(), 96u);
+}
+
+TEST(TimerWheel, RemoveUnlinksOnlyArmedTimers) {
+    TimerWheel wheel;
+    std::vector<TimerNode> nodes(4);
+    const std::uint64_t due[] = {3, 3, 70, 5000};
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].dueTick = due[i];
+        wheel.insert(&nodes[i]);
+    }
+
+    // Head, middle-of-slot and higher-level entries all unlink in place.
+    EXPECT_TRUE(wheel.remove(&nodes[1]));
+    EXPECT_TRUE(wheel.remove(&nodes[3]));
+    EXPECT_FALSE(wheel.remove(&nodes[3]));
+    EXPECT_EQ(wheel.size(), 2u);
+
+    EXPECT_EQ(DueTicks(wheel.advance(3)), (std::vector<std::uint64_t>{3}));
+    EXPECT_FALSE(wheel.remove(&nodes[0]));
+    EXPECT_EQ(DueTicks(wheel.advance(100)), (std::vector<std::uint64_t>{70}));
+    EXPECT_EQ(wheel.advance(10000), nullptr);
+    EXPECT_TRUE(wheel.empty());
+}
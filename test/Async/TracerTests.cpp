@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "Async/Task.h"
+#include "Async/Tracer.h"
+#include "time/FrameScheduler.h"
+
+namespace {
+
+soul::async::Task<void> Noop() {
+    co_return;
+}
+
+} // namespace
+
+TEST(Tracer, RecordsOnlyWhileStartedAndKeepsNewestEvents) {
+    soul::async::Tracer tracer(4);
+    const auto now = soul::async::Tracer::Clock::now();
+
+    tracer.slice("ignored", now, now);
+    tracer.start();
+    for (int i = 0; i < 6; ++i) {
+        tracer.slice(i < 2 ? "old" : "new", now, now, static_cast<std::uint64_t>(i));
+    }
+
+    const auto traces = tracer.collect();
+    EXPECT_FALSE(tracer.is_recording());
+    ASSERT_EQ(traces.size(), 1u);
+    EXPECT_EQ(traces[0].dropped, 2u);
+    ASSERT_EQ(traces[0].events.size(), 4u);
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_STREQ(traces[0].events[i].name, "new");
+        EXPECT_EQ(traces[0].events[i].id, i + 2);
+    }
+
+    tracer.clear();
+    EXPECT_TRUE(tracer.collect()[0].events.empty());
+}
+
+TEST(Tracer, EachThreadGetsItsOwnTrack) {
+    soul::async::Tracer tracer;
+    tracer.start();
+    std::thread other([&] {
+        tracer.set_thread_name("other");
+        tracer.task_begin("work", 1);
+        tracer.task_end("work", 1);
+    });
+    other.join();
+    tracer.flow_start(2);
+
+    const auto traces = tracer.collect();
+    ASSERT_EQ(traces.size(), 2u);
+    const auto named = std::find_if(traces.begin(), traces.end(), [](const auto& trace) {
+        return trace.name == "other";
+    });
+    ASSERT_NE(named, traces.end());
+    EXPECT_EQ(named->events.size(), 2u);
+    EXPECT_NE(traces[0].threadId, traces[1].threadId);
+}
+
+TEST(Tracer, ExportsFrameTasksWorkersAndDependencyFlows) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    scheduler->set_tracer(std::make_shared<soul::async::Tracer>());
+    scheduler->tracer()->start();
+
+    soul::time::FrameScheduler frame(scheduler);
+    auto physics = frame.schedule("Physics", Noop());
+    auto animation = frame.schedule("Animation", Noop());
+    const std::array dependencies{physics.token, animation.token};
+    auto render = frame.schedule("Render", Noop(), dependencies);
+    frame.wait_for_all();
+
+    // A worker records the "job" slice after the job returns, possibly after wait_for_all has
+    // returned; joining the workers first makes sure every one is in the trace.
+    scheduler->stop();
+    std::stringstream out;
+    scheduler->tracer()->write_chrome_trace(out);
+
+    const auto document = nlohmann::json::parse(out.str());
+    std::set<std::string> slices;
+    std::set<std::string> threadNames;
+    std::multiset<std::string> spans;
+    std::set<std::uint64_t> flowStarts;
+    std::set<std::uint64_t> flowEnds;
+    for (const auto& event : document.at("traceEvents")) {
+        const auto phase = event.at("ph").get<std::string>();
+        if (phase == "X") {
+            slices.insert(event.at("name").get<std::string>());
+        } else if (phase == "M" && event.at("name") == "thread_name") {
+            threadNames.insert(event.at("args").at("name").get<std::string>());
+        } else if (phase == "b" || phase == "e") {
+            spans.insert(event.at("name").get<std::string>() + phase);
+        } else if (phase == "s") {
+            flowStarts.insert(event.at("id").get<std::uint64_t>());
+        } else if (phase == "f") {
+            flowEnds.insert(event.at("id").get<std::uint64_t>());
+        }
+    }
+
+    for (const auto* name : {"Physics", "Animation", "Render"}) {
+        EXPECT_TRUE(slices.count(name)) << name;
+        EXPECT_EQ(spans.count(std::string(name) + "b"), 1u) << name;
+        EXPECT_EQ(spans.count(std::string(name) + "e"), 1u) << name;
+    }
+    EXPECT_TRUE(slices.count("job"));
+    EXPECT_TRUE(threadNames.count("worker 0") || threadNames.count("worker 1"));
+    // Render's two edges each draw an arrow, unless a dependency finished before Render was
+    // scheduled; every arrow that starts also ends.
+    EXPECT_LE(flowStarts.size(), 2u);
+    EXPECT_EQ(flowStarts, flowEnds);
+}
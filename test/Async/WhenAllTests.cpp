@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "Async/Task.h"
+#include "Async/WhenAll.h"
+
+namespace {
+
+soul::async::Task<int> Immediate(int value) {
+    co_return value;
+}
+
+soul::async::Task<void> Throws() {
+    throw std::runtime_error("child failed");
+    co_return;
+}
+
+} // namespace
+
+TEST(WhenAll, VariadicJoinYieldsEveryResult) {
+    soul::async::TaskScheduler scheduler(2);
+
+    auto joiner = [&]() -> soul::async::Task<std::tuple<int, std::string, std::monostate>> {
+        auto join = soul::async::when_all(scheduler.run_async([]() { return 7; }),
+                                          scheduler.run_async([]() { return std::string("soul"); }),
+                                          scheduler.run_async([]() {}));
+        co_return co_await join;
+    };
+
+    const auto [number, text, nothing] = joiner().get();
+    EXPECT_EQ(number, 7);
+    EXPECT_EQ(text, "soul");
+}
+
+TEST(WhenAll, RangeJoinKeepsInputOrder) {
+    soul::async::TaskScheduler scheduler(4);
+
+    auto joiner = [&]() -> soul::async::Task<std::vector<int>> {
+        std::vector<soul::async::Task<int>> tasks;
+        for (int i = 0; i < 64; ++i) {
+            tasks.push_back(scheduler.run_async([i]() {
+                std::this_thread::sleep_for(std::chrono::microseconds((64 - i) * 10));
+                return i;
+            }));
+        }
+        auto join = soul::async::when_all(std::move(tasks));
+        co_return co_await join;
+    };
+
+    const auto results = joiner().get();
+    ASSERT_EQ(results.size(), 64u);
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(results[i], i);
+    }
+}
+
+TEST(WhenAll, StartsLazyChildrenAndHandlesCompletedOnes) {
+    soul::async::TaskScheduler scheduler(1);
+    auto joiner = [&]() -> soul::async::Task<int> {
+        auto done = scheduler.run_async([]() { return 1; });
+        scheduler.wait(done.token());
+        auto join = soul::async::when_all(std::move(done), Immediate(2), Immediate(3));
+        auto [a, b, c] = co_await join;
+        co_return a + b + c;
+    };
+    EXPECT_EQ(joiner().get(), 6);
+
+    auto empty = []() -> soul::async::Task<void> {
+        auto join = soul::async::when_all(std::vector<soul::async::Task<void>>{});
+        co_await join;
+    };
+    empty().get();
+}
+
+TEST(WhenAll, LastChildResumesTheJoinerInline) {
+    soul::async::TaskScheduler scheduler(2);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    std::atomic<std::thread::id> lastChildThread{};
+
+    auto joiner = [&]() -> soul::async::Task<bool> {
+        auto fast = scheduler.run_async([]() {});
+        auto slow = scheduler.run_async([&]() {
+            gate.wait();
+            lastChildThread.store(std::this_thread::get_id());
+        });
+        auto join = soul::async::when_all(std::move(fast), std::move(slow));
+        co_await join;
+        co_return std::this_thread::get_id() == lastChildThread.load();
+    };
+
+    auto task = joiner();
+    auto result = std::async(std::launch::async, [&task]() { return task.get(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    release.set_value();
+    EXPECT_TRUE(result.get());
+}
+
+TEST(WhenAll, RethrowsAfterEveryChildFinished) {
+    soul::async::TaskScheduler scheduler(2);
+    std::atomic_bool slowFinished{false};
+
+    auto joiner = [&]() -> soul::async::Task<void> {
+        auto slow = scheduler.run_async([&slowFinished]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            slowFinished.store(true);
+        });
+        auto join = soul::async::when_all(std::move(slow), Throws());
+        co_await join;
+    };
+
+    EXPECT_THROW(joiner().get(), std::runtime_error);
+    EXPECT_TRUE(slowFinished.load());
+}
+
+TEST(WhenAny, ResumesWithTheFirstFinisher) {
+    soul::async::TaskScheduler scheduler(2);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+
+    auto joiner = [&]() -> soul::async::Task<soul::async::WhenAnyResult<int>> {
+        std::vector<soul::async::Task<int>> tasks;
+        tasks.push_back(scheduler.run_async([gate]() {
+            gate.wait();
+            return 1;
+        }));
+        tasks.push_back(scheduler.run_async([]() { return 2; }));
+        auto race = soul::async::when_any(std::move(tasks));
+        co_return co_await race;
+    };
+
+    const auto winner = joiner().get();
+    EXPECT_EQ(winner.index, 1u);
+    EXPECT_EQ(winner.value, 2);
+
+    // The losing child still holds the join state; letting it finish must be safe.
+    release.set_value();
+    scheduler.run_async([]() {}).get();
+}
+
+TEST(WhenAny, ManyRacesReleaseTheirState) {
+    soul::async::TaskScheduler scheduler(4);
+    for (int round = 0; round < 200; ++round) {
+        auto joiner = [&]() -> soul::async::Task<std::size_t> {
+            std::vector<soul::async::Task<void>> tasks;
+            for (int i = 0; i < 4; ++i) {
+                tasks.push_back(scheduler.run_async([]() {}));
+            }
+            auto race = soul::async::when_any(std::move(tasks));
+            co_return (co_await race).index;
+        };
+        EXPECT_LT(joiner().get(), 4u);
+    }
+}
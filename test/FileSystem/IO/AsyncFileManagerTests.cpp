@@ -2,6 +2,8 @@
 
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <system_error>
 #include <vector>
 
 #include "Async/Task.h"
@@ -44,3 +46,48 @@ TEST(AsyncFileManager, ReadTextMatchesWrite) {
 
     fs::remove(tempPath);
 }
+
+TEST(AsyncFileManager, ReadAllLoadsFilesConcurrently) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    auto ioBackend = std::make_shared<soul::filesystem::io::ThreadPoolAsyncFileIO>(scheduler);
+    soul::filesystem::core::AsyncFileManager manager(ioBackend);
+
+    std::vector<fs::path> paths;
+    for (int i = 0; i < 8; ++i) {
+        paths.push_back(fs::temp_directory_path() / ("soul_async_fs_batch_" + std::to_string(i) + ".txt"));
+        ASSERT_FALSE(manager.write_text(paths.back(), std::to_string(i)).get().error);
+    }
+    paths.push_back(fs::temp_directory_path() / "soul_async_fs_batch_missing.txt");
+    fs::remove(paths.back());
+
+    auto results = manager.read_all(paths).get();
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_FALSE(results[i].error) << results[i].error.message();
+        EXPECT_EQ(std::string(reinterpret_cast<const char*>(results[i].data.data()), results[i].data.size()),
+                  std::to_string(i));
+        fs::remove(paths[i]);
+    }
+    EXPECT_TRUE(results.back().error);
+}
+
+TEST(AsyncFileManager, CancelledRequestsNeverTouchTheFile) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    auto ioBackend = std::make_shared<soul::filesystem::io::ThreadPoolAsyncFileIO>(scheduler);
+    soul::filesystem::core::AsyncFileManager manager(ioBackend);
+
+    const fs::path tempPath = fs::temp_directory_path() / "soul_async_fs_cancelled.bin";
+    fs::remove(tempPath);
+    std::vector<std::byte> payload = {std::byte{0x5}};
+
+    soul::async::CancellationSource source;
+    source.cancel();
+
+    auto writeResult = manager.write(tempPath, payload, source.token()).get();
+    EXPECT_EQ(writeResult.error, std::make_error_code(std::errc::operation_canceled));
+    EXPECT_FALSE(fs::exists(tempPath));
+
+    auto readResult = manager.read(tempPath, source.token()).get();
+    EXPECT_EQ(readResult.error, std::make_error_code(std::errc::operation_canceled));
+}
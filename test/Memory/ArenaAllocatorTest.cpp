@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <vector>
 #include "Memory/Core/ArenaAllocator.h"
 #include "Memory/Core/MemoryManager.h"
 #include "Memory/Core/MemoryRegistry.h"
@@ -60,3 +61,80 @@ TEST_F(ArenaAllocatorTest, ThrowsWhenOutOfMemory) {
     EXPECT_NO_THROW(arena.allocate(16));
     EXPECT_THROW(arena.allocate(32), std::bad_alloc);
 }
+
+TEST_F(ArenaAllocatorTest, ChainedArenaGrowsByAppendingBlocks) {
+    const MemoryTag tag = SOUL_MEMORY_TAG("chained-arena");
+    ArenaAllocator arena(manager, 64, tag, ArenaGrowth::Chained);
+    (void)arena.allocate(48);
+    EXPECT_EQ(arena.blockCount(), 1u);
+    void* spilled = arena.allocate(48);
+    ASSERT_NE(spilled, nullptr);
+    EXPECT_EQ(arena.blockCount(), 2u);
+    EXPECT_EQ(arena.capacity(), 64u + 128u);
+    EXPECT_EQ(manager.getAllocatedByTag(tag), arena.capacity());
+
+    // Requests larger than twice the last block get a block of their own size.
+    (void)arena.allocate(1000);
+    EXPECT_EQ(arena.blockCount(), 3u);
+    EXPECT_GE(arena.capacity(), 64u + 128u + 1000u);
+}
+
+TEST_F(ArenaAllocatorTest, ResetReusesRetainedBlocks) {
+    ArenaAllocator arena(manager, 64, SOUL_MEMORY_TAG("ArenaAllocator"), ArenaGrowth::Chained);
+    std::vector<void*> firstFrame;
+    for (int i = 0; i < 8; ++i) {
+        firstFrame.push_back(arena.allocate(40));
+    }
+    const auto blocks = arena.blockCount();
+    const auto capacity = arena.capacity();
+    EXPECT_GT(blocks, 1u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(arena.allocate(40), firstFrame[i]);
+    }
+    EXPECT_EQ(arena.blockCount(), blocks);
+    EXPECT_EQ(arena.capacity(), capacity);
+
+    arena.reset();
+    (void)arena.allocate(16);
+    arena.releaseUnused();
+    EXPECT_EQ(arena.blockCount(), 1u);
+    EXPECT_EQ(manager.getTotalAllocated(), arena.capacity());
+}
+
+TEST_F(ArenaAllocatorTest, RewindReleasesAllocationsAfterMarker) {
+    ArenaAllocator arena(manager, 64, SOUL_MEMORY_TAG("ArenaAllocator"), ArenaGrowth::Chained);
+    (void)arena.allocate(16);
+    const auto marker = arena.mark();
+    const auto usedAtMarker = arena.used();
+    void* temporary = arena.allocate(32);
+    (void)arena.allocate(200);
+    EXPECT_GT(arena.blockCount(), 1u);
+
+    arena.rewind(marker);
+    EXPECT_EQ(arena.used(), usedAtMarker);
+    EXPECT_EQ(arena.allocate(32), temporary);
+}
+
+TEST_F(ArenaAllocatorTest, ScopedArenaRewindsOnExit) {
+    ArenaAllocator arena(manager, 128, SOUL_MEMORY_TAG("ArenaAllocator"), ArenaGrowth::Chained);
+    (void)arena.allocate(8);
+    const auto used = arena.used();
+    {
+        ScopedArena scratch(arena);
+        auto* values = static_cast<std::uint64_t*>(scratch.allocate(64 * sizeof(std::uint64_t), alignof(std::uint64_t)));
+        values[63] = 7;
+        EXPECT_EQ(*scratch.create<int>(5), 5);
+        EXPECT_GT(arena.used(), used);
+    }
+    EXPECT_EQ(arena.used(), used);
+}
+
+TEST_F(ArenaAllocatorTest, HonoursAlignmentAboveTheDefault) {
+    ArenaAllocator arena(manager, 256);
+    (void)arena.allocate(1, 1);
+    void* aligned = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+}
@@ -2,6 +2,9 @@
 #include "Memory/Core/MemoryManager.h"
 #include "Memory/Core/MemoryRegistry.h"
 #include "Memory/Core/MemoryTag.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
 
 using namespace Memory::Core;
 
@@ -56,3 +59,80 @@ TEST_F(MemoryManagerTest, ClearAll) {
     EXPECT_EQ(manager.getAllocationCount(), 0u);
     EXPECT_EQ(manager.getTotalAllocated(), 0u);
 }
+
+TEST_F(MemoryManagerTest, ManyRecordsSurviveGrowthAndErase) {
+    constexpr std::uintptr_t kCount = 5000;
+    auto address = [](std::uintptr_t i) { return reinterpret_cast<void*>(0x10000 + i * 16); };
+    for (std::uintptr_t i = 0; i < kCount; ++i) {
+        manager.registerAllocation(address(i), i + 1, SOUL_MEMORY_TAG("bulk"));
+    }
+    EXPECT_EQ(manager.getAllocationCount(), kCount);
+
+    // Erase every other record, then check the rest is still reachable.
+    for (std::uintptr_t i = 0; i < kCount; i += 2) {
+        manager.unregisterAllocation(address(i));
+    }
+    EXPECT_EQ(manager.getAllocationCount(), kCount / 2);
+    for (std::uintptr_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(manager.getAllocationSize(address(i)), i % 2 == 0 ? 0u : i + 1);
+    }
+    manager.unregisterAllocation(address(0));
+    EXPECT_EQ(manager.getAllocationCount(), kCount / 2);
+}
+
+TEST_F(MemoryManagerTest, ConcurrentTrackingFromManyThreads) {
+    constexpr int kThreads = 4;
+    constexpr std::uintptr_t kPerThread = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this, t]() {
+            const auto base = 0x100000 * static_cast<std::uintptr_t>(t + 1);
+            for (std::uintptr_t i = 0; i < kPerThread; ++i) {
+                manager.registerAllocation(reinterpret_cast<void*>(base + i * 32), 8, SOUL_MEMORY_TAG("threads"));
+            }
+            // Keep one in four records alive.
+            for (std::uintptr_t i = 0; i < kPerThread; ++i) {
+                if (i % 4 != 0) {
+                    manager.unregisterAllocation(reinterpret_cast<void*>(base + i * 32));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(manager.getAllocationCount(), kThreads * kPerThread / 4);
+    EXPECT_EQ(manager.getAllocatedByTag(SOUL_MEMORY_TAG("threads")), kThreads * kPerThread / 4 * 8);
+}
+
+TEST_F(MemoryManagerTest, RunningCountersFollowReplacementAndCrossThreadFrees) {
+    void* ptr = reinterpret_cast<void*>(0x5000);
+    manager.registerAllocation(ptr, 16, SOUL_MEMORY_TAG("first"));
+    // Registering the same pointer again replaces its record rather than double counting.
+    manager.registerAllocation(ptr, 48, SOUL_MEMORY_TAG("second"));
+    EXPECT_EQ(manager.getAllocationCount(), 1u);
+    EXPECT_EQ(manager.getTotalAllocated(), 48u);
+    EXPECT_EQ(manager.getAllocatedByTag(SOUL_MEMORY_TAG("first")), 0u);
+    EXPECT_EQ(manager.getAllocatedByTag(SOUL_MEMORY_TAG("second")), 48u);
+
+    // Freed on another thread: that thread's stripe goes negative, the sums stay right.
+    std::thread([this, ptr]() { manager.unregisterAllocation(ptr); }).join();
+    EXPECT_EQ(manager.getAllocationCount(), 0u);
+    EXPECT_EQ(manager.getTotalAllocated(), 0u);
+    EXPECT_EQ(manager.getAllocatedByTag(SOUL_MEMORY_TAG("second")), 0u);
+    EXPECT_TRUE(manager.snapshot().tags.empty());
+}
+
+TEST_F(MemoryManagerTest, PerTagFiguresBeyondTheSlotLimit) {
+    constexpr uint32_t kTags = TagCounters::kTagSlots * 2;
+    for (uint32_t i = 0; i < kTags; ++i) {
+        manager.registerAllocation(reinterpret_cast<void*>(0x100000 + i * 16), i + 1, MemoryTag(1000 + i));
+    }
+    for (uint32_t i = 0; i < kTags; ++i) {
+        EXPECT_EQ(manager.getAllocatedByTag(MemoryTag(1000 + i)), i + 1);
+    }
+    const auto stats = manager.snapshot();
+    EXPECT_EQ(stats.tags.size(), kTags);
+    EXPECT_EQ(stats.allocationCount, kTags);
+    EXPECT_EQ(stats.totalBytes, kTags * (kTags + 1) / 2);
+}
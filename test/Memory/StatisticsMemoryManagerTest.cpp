@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "Memory/Core/MemoryAllocator.h"
+#include "Memory/Core/StatisticsMemoryManager.h"
+#include "Memory/Core/TaggedMemoryAllocator.h"
+#include "Memory/Core/ArenaAllocator.h"
+#include "Memory/Core/PoolAllocator.h"
+#include <cstdint>
+#include <list>
+#include <vector>
+
+using namespace Memory::Core;
+
+namespace {
+struct StatsTag {
+    static constexpr MemoryTag value() noexcept { return SOUL_MEMORY_TAG("StatsTag"); }
+};
+} // namespace
+
+TEST(StatisticsMemoryManagerTest, CountsThroughSizedReleases) {
+    StatisticsMemoryManager manager;
+    {
+        std::vector<std::uint32_t, MemoryAllocator<std::uint32_t>> values{MemoryAllocator<std::uint32_t>(manager)};
+        values.resize(100);
+        std::list<int, TaggedMemoryAllocator<int, StatsTag>> nodes{TaggedMemoryAllocator<int, StatsTag>(manager)};
+        nodes.assign(10, 7);
+
+        EXPECT_GE(manager.getTotalAllocated(), 100 * sizeof(std::uint32_t));
+        EXPECT_EQ(manager.getAllocatedByTag(StatsTag::value()) % 10, 0u);
+        EXPECT_GE(manager.getAllocationCount(), 11u);
+        EXPECT_EQ(manager.getAllocationSize(values.data()), 0u);
+    }
+    EXPECT_EQ(manager.getTotalAllocated(), 0u);
+    EXPECT_EQ(manager.getAllocationCount(), 0u);
+    EXPECT_TRUE(manager.snapshot().tags.empty());
+}
+
+TEST(StatisticsMemoryManagerTest, BlockAllocatorsReleaseWithTheirTag) {
+    StatisticsMemoryManager manager;
+    {
+        ArenaAllocator arena(manager, 4096, SOUL_MEMORY_TAG("stats-arena"));
+        PoolAllocator<std::uint64_t, 64> pool(manager, SOUL_MEMORY_TAG("stats-pool"));
+        EXPECT_EQ(manager.getAllocatedByTag(SOUL_MEMORY_TAG("stats-arena")), 4096u);
+        EXPECT_GE(manager.getAllocatedByTag(SOUL_MEMORY_TAG("stats-pool")), 64 * sizeof(std::uint64_t));
+        EXPECT_EQ(manager.snapshot().tags.size(), 2u);
+    }
+    EXPECT_EQ(manager.getTotalAllocated(), 0u);
+
+    // Unsized releases carry nothing to subtract and are ignored.
+    manager.registerAllocation(reinterpret_cast<void*>(0x1000), 32, SOUL_MEMORY_TAG("raw"));
+    manager.unregisterAllocation(reinterpret_cast<void*>(0x1000));
+    EXPECT_EQ(manager.getTotalAllocated(), 32u);
+    manager.clear();
+    EXPECT_EQ(manager.getTotalAllocated(), 0u);
+}
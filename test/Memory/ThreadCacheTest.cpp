@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "Memory/Core/MemoryAllocator.h"
+#include "Memory/Core/MemoryManager.h"
+#include "Memory/Core/StatisticsMemoryManager.h"
+#include "Memory/Core/ThreadCache.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace Memory::Core;
+
+TEST(ThreadCacheTest, ReusesBlocksWithinASizeClass) {
+    void* first = ThreadCache::allocate(24);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % ThreadCache::kAlignment, 0u);
+    const size_t cached = ThreadCache::cachedBlocks();
+    ThreadCache::deallocate(first, 24);
+    EXPECT_EQ(ThreadCache::cachedBlocks(), cached + 1);
+    // 17 to 32 bytes share a class, so the block just freed comes straight back.
+    void* second = ThreadCache::allocate(32);
+    EXPECT_EQ(second, first);
+    ThreadCache::deallocate(second, 32);
+
+    // Large requests bypass the cache.
+    void* large = ThreadCache::allocate(ThreadCache::kMaxSmallSize + 1);
+    ThreadCache::deallocate(large, ThreadCache::kMaxSmallSize + 1);
+    EXPECT_EQ(ThreadCache::cachedBlocks(), cached + 1);
+
+    ThreadCache::releaseCachedBlocks();
+    EXPECT_EQ(ThreadCache::cachedBlocks(), 0u);
+}
+
+TEST(ThreadCacheTest, BlocksMoveBetweenThreadsWithoutReuseWhileLive) {
+    constexpr size_t kBlocks = 2000;
+    std::vector<void*> produced(kBlocks);
+    std::thread producer([&] {
+        for (auto& block : produced) {
+            block = ThreadCache::allocate(48);
+        }
+    });
+    producer.join();
+
+    // The producer has exited; its spare blocks went back to the central lists and can be handed
+    // out here, but never one that is still live.
+    std::vector<void*> local(kBlocks);
+    for (auto& block : local) {
+        block = ThreadCache::allocate(48);
+    }
+    std::set<void*> unique(produced.begin(), produced.end());
+    unique.insert(local.begin(), local.end());
+    EXPECT_EQ(unique.size(), 2 * kBlocks);
+
+    std::thread consumer([&] {
+        for (auto* block : produced) {
+            ThreadCache::deallocate(block, 48);
+        }
+    });
+    consumer.join();
+    for (auto* block : local) {
+        ThreadCache::deallocate(block, 48);
+    }
+}
+
+TEST(ThreadCacheTest, BatchesAccountingPerThread) {
+    StatisticsMemoryManager manager;
+    std::atomic<int> step {0};
+    std::thread worker([&] {
+        MemoryAllocator<std::uint64_t> allocator(manager);
+        std::vector<std::uint64_t*> blocks;
+        for (int i = 0; i < 10; ++i) {
+            blocks.push_back(allocator.allocate(1));
+        }
+        step = 1;
+        step.notify_all();
+        step.wait(1);
+        ThreadCache::flushAccounting();
+        step = 3;
+        step.notify_all();
+        step.wait(3);
+        for (auto* block : blocks) {
+            allocator.deallocate(block, 1);
+        }
+    });
+
+    step.wait(0);
+    // Still pending in the worker's batch.
+    EXPECT_EQ(manager.getAllocationCount(), 0u);
+    step = 2;
+    step.notify_all();
+    step.wait(2);
+    EXPECT_EQ(manager.getAllocationCount(), 10u);
+    EXPECT_EQ(manager.getTotalAllocated(), 10 * sizeof(std::uint64_t));
+    step = 4;
+    step.notify_all();
+    worker.join();
+    // Applied when the worker exited.
+    EXPECT_EQ(manager.getAllocationCount(), 0u);
+}
+
+TEST(ThreadCacheTest, PerPointerManagersSeeEveryBlock) {
+    MemoryManager manager;
+    MemoryAllocator<std::uint32_t> allocator(manager);
+    auto* value = allocator.allocate(3);
+    EXPECT_EQ(manager.getAllocationSize(value), 3 * sizeof(std::uint32_t));
+    EXPECT_EQ(manager.getAllocationCount(), 1u);
+    allocator.deallocate(value, 3);
+    EXPECT_EQ(manager.getAllocationCount(), 0u);
+}
+
+TEST(ThreadCacheTest, PendingBatchForDestroyedManagerIsDropped) {
+    auto first = std::make_unique<StatisticsMemoryManager>();
+    MemoryAllocator<int> allocator(*first);
+    int* value = allocator.allocate(1);
+    first.reset();
+    ThreadCache::flushAccounting();
+    ThreadCache::deallocate(value, sizeof(int));
+
+    StatisticsMemoryManager second;
+    EXPECT_EQ(second.getTotalAllocated(), 0u);
+}
@@ -2,6 +2,7 @@
 #include <utility>
 #include <optional>
 #include <functional>
+#include <random>
 #include <gtest/gtest.h>
 #include "containers/Algorithms/Sorter.h"
 #include "containers/Algorithms/Searcher.h"
@@ -45,6 +46,37 @@ TEST(SorterTests, StableSort) {
     EXPECT_EQ(v[2].second, 'c');
 }
 
+TEST(SorterTests, SortWithSchedulerMatchesSerialSort) {
+    soul::async::TaskScheduler scheduler(4);
+    std::mt19937 rng(42);
+    std::vector<int> v(50000);
+    for (auto& value : v) {
+        value = static_cast<int>(rng() % 100000);
+    }
+    auto expected = v;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+    Sorter::sortDescending(v, scheduler);
+    EXPECT_EQ(v, expected);
+
+    Sorter::sortAscending(v, scheduler);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+}
+
+TEST(SorterTests, StableSortWithScheduler) {
+    soul::async::TaskScheduler scheduler(4);
+    std::vector<std::pair<int, int>> v(40000);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = {static_cast<int>(i % 13), static_cast<int>(i)};
+    }
+    std::function<bool(const std::pair<int, int>&, const std::pair<int, int>&)> comp =
+        [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+            return a.first < b.first;
+        };
+    Sorter::stableSort(v, comp, scheduler);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+}
+
 TEST(SearcherTests, FindFirst) {
     std::vector<int> v = {1, 2, 3, 4};
     // Explicitly create a std::function to match the expected type
@@ -96,6 +96,23 @@ TEST(SequentialContainers, VectorConstructFromRange) {
     }
 }
 
+TEST(SequentialContainers, VectorSortAndScanOnScheduler) {
+    soul::async::TaskScheduler scheduler(4);
+    SoulVector<int> vec;
+    for (int i = 0; i < 20000; ++i) {
+        vec.insert((i * 7919) % 20000);
+    }
+
+    const auto matches = vec.findAll([](const int& value) { return value % 1000 == 0; }, scheduler);
+    EXPECT_EQ(matches, vec.findAll([](const int& value) { return value % 1000 == 0; }));
+
+    vec.sort([](const int& a, const int& b) { return a < b; }, scheduler);
+    ASSERT_EQ(vec.size(), 20000u);
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_EQ(vec.begin()[i], i);
+    }
+}
+
 TEST(SequentialContainers, VectorAppendRangeExtendsSequence) {
     SoulVector<int> vec {1, 2};
     const std::vector<int> more {3, 4, 5};
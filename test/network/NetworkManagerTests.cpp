@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "Async/Task.h"
 #include "Networking/NetworkManager.h"
@@ -47,6 +50,39 @@ private:
     std::size_t m_dropsRemaining{0};
 };
 
+class RecordingTransport final : public soul::net::Transport {
+public:
+    explicit RecordingTransport(std::shared_ptr<soul::async::TaskScheduler> scheduler)
+        : m_scheduler(std::move(scheduler)) {}
+
+    bool bind(const soul::net::Endpoint&) override {
+        return true;
+    }
+
+    void close() override {}
+
+    soul::async::Task<void> send(const soul::net::Endpoint&, soul::net::Packet packet) override {
+        auto channel = packet.header.channel;
+        auto task = m_scheduler->run_async([this, channel]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::lock_guard lock(m_mutex);
+            channels.push_back(channel);
+        });
+        co_await task;
+    }
+
+    soul::async::Task<std::optional<std::pair<soul::net::Endpoint, soul::net::Packet>>>
+    receive() override {
+        co_return std::nullopt;
+    }
+
+    std::vector<std::uint16_t> channels;
+
+private:
+    std::shared_ptr<soul::async::TaskScheduler> m_scheduler;
+    std::mutex m_mutex;
+};
+
 } // namespace
 
 TEST(NetworkManager, UdpSendAndReceive) {
@@ -145,3 +181,26 @@ TEST(NetworkManager, UdpReliableRetransmission) {
     // Allow time for ACK to propagate so that retransmission backlog clears without exceeding retries.
     std::this_thread::sleep_for(std::chrono::milliseconds(150));
 }
+
+TEST(NetworkManager, SendBatchIssuesEverySendConcurrently) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(4);
+    auto tcp = std::make_shared<RecordingTransport>(scheduler);
+    auto udp = std::make_shared<RecordingTransport>(scheduler);
+    soul::net::NetworkManager manager(scheduler, tcp, udp);
+
+    std::vector<soul::net::Packet> packets(8);
+    for (std::uint16_t i = 0; i < packets.size(); ++i) {
+        packets[i].header.channel = i;
+        packets[i].header.guarantee = soul::net::DeliveryGuarantee::Unreliable;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    manager.send_batch(soul::net::Endpoint::from_string("127.0.0.1", kPortA), std::move(packets)).get();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto channels = udp->channels;
+    std::sort(channels.begin(), channels.end());
+    EXPECT_EQ(channels, (std::vector<std::uint16_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+    // Eight 5 ms sends on four workers: serialised they would take at least 40 ms.
+    EXPECT_LT(elapsed, std::chrono::milliseconds(40));
+}
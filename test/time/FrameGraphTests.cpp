@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Async/Task.h"
+#include "time/FrameGraph.h"
+
+TEST(FrameGraph, CompileRejectsUnknownIdsDuplicateNamesAndCycles) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+
+    soul::time::FrameGraph::Builder unknown;
+    const auto a = unknown.add("A", [] {});
+    unknown.depends_on(a, 7);
+    EXPECT_THROW((void)unknown.compile(scheduler), std::invalid_argument);
+
+    soul::time::FrameGraph::Builder duplicate;
+    duplicate.add("A", [] {});
+    duplicate.add("A", [] {});
+    EXPECT_THROW((void)duplicate.compile(scheduler), std::invalid_argument);
+
+    soul::time::FrameGraph::Builder cyclic;
+    const auto first = cyclic.add("First", [] {});
+    const auto second = cyclic.add("Second", [] {});
+    cyclic.add("Free", [] {});
+    cyclic.depends_on(first, second).depends_on(second, first);
+    try {
+        (void)cyclic.compile(scheduler);
+        FAIL() << "cycle was accepted";
+    } catch (const std::invalid_argument& error) {
+        const std::string message = error.what();
+        EXPECT_NE(message.find("First"), std::string::npos);
+        EXPECT_NE(message.find("Second"), std::string::npos);
+        EXPECT_EQ(message.find("Free"), std::string::npos);
+    }
+}
+
+TEST(FrameGraph, ReplaysDependenciesInOrderEveryFrame) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+
+    // Diamond: Input -> (Physics, Animation) -> Render, declared out of order.
+    std::array<std::atomic_int, 4> finishedAt{};
+    std::atomic_int clock{0};
+    std::atomic_bool ordered{true};
+    const auto mark = [&](int node) {
+        finishedAt[node].store(++clock);
+    };
+
+    soul::time::FrameGraph::Builder builder;
+    const auto render = builder.add("Render", [&] {
+        if (finishedAt[1].load() <= finishedAt[0].load() || finishedAt[2].load() <= finishedAt[0].load()) {
+            ordered = false;
+        }
+        mark(3);
+    });
+    const auto physics = builder.add("Physics", [&] { mark(1); });
+    const auto animation = builder.add("Animation", [&] { mark(2); });
+    const auto input = builder.add("Input", [&] {
+        for (auto& value : finishedAt) {
+            value.store(0);
+        }
+        mark(0);
+    });
+    builder.depends_on(physics, input).depends_on(animation, input);
+    builder.depends_on(render, physics).depends_on(render, animation).depends_on(render, physics);
+
+    auto graph = builder.compile(scheduler);
+    ASSERT_EQ(graph.size(), 4u);
+    EXPECT_EQ(graph.name(render), "Render");
+    const auto order = graph.topological_order();
+    EXPECT_EQ(order.front(), input);
+    EXPECT_EQ(order.back(), render);
+
+    for (int frame = 0; frame < 200; ++frame) {
+        graph.execute();
+        ASSERT_GT(finishedAt[3].load(), 0) << "frame " << frame;
+    }
+    EXPECT_TRUE(ordered.load());
+}
+
+TEST(FrameGraph, WaitRethrowsWhileEveryNodeStillRuns) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    std::atomic_int ran{0};
+
+    soul::time::FrameGraph::Builder builder;
+    const auto failing = builder.add("Failing", [&] {
+        ++ran;
+        throw std::runtime_error("boom");
+    });
+    const std::array dependencies{failing};
+    builder.add("After", [&] { ++ran; }, dependencies);
+    auto graph = builder.compile(scheduler);
+
+    EXPECT_THROW(graph.execute(), std::runtime_error);
+    EXPECT_EQ(ran.load(), 2);
+    // The error belongs to its replay; the next one starts clean.
+    EXPECT_THROW(graph.execute(), std::runtime_error);
+    EXPECT_EQ(ran.load(), 4);
+}
+
+TEST(FrameGraph, DispatchWhileRunningThrows) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    std::atomic_bool release{false};
+
+    soul::time::FrameGraph::Builder builder;
+    builder.add("Blocking", [&] {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    auto graph = builder.compile(scheduler);
+
+    graph.dispatch();
+    EXPECT_THROW(graph.dispatch(), std::logic_error);
+    release = true;
+    graph.wait();
+    EXPECT_NO_THROW(graph.execute());
+}
+
+TEST(FrameGraph, MoveAssignmentWaitsForTheRunningReplay) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    std::atomic_bool finished{false};
+
+    soul::time::FrameGraph::Builder slow;
+    slow.add("Slow", [&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        finished = true;
+    });
+    auto graph = slow.compile(scheduler);
+    graph.dispatch();
+
+    soul::time::FrameGraph::Builder other;
+    other.add("Other", [] {});
+    graph = other.compile(scheduler);
+    EXPECT_TRUE(finished.load());
+    EXPECT_EQ(graph.name(0), "Other");
+
+    // A moved-from graph behaves as an empty one.
+    auto moved = std::move(graph);
+    EXPECT_EQ(graph.size(), 0u);
+    EXPECT_TRUE(graph.topological_order().empty());
+    EXPECT_THROW((void)graph.name(0), std::out_of_range);
+    EXPECT_NO_THROW(graph.execute());
+    EXPECT_NO_THROW(moved.execute());
+}
+
+TEST(FrameGraph, ReplaysFinishAfterTheSchedulerStops) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    std::atomic_bool started{false};
+    std::atomic_int runs{0};
+
+    soul::time::FrameGraph::Builder builder;
+    const auto slow = builder.add("Slow", [&] {
+        started = true;
+        started.notify_all();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ++runs;
+    });
+    const auto left = builder.add("Left", [&] { ++runs; });
+    const auto right = builder.add("Right", [&] { ++runs; });
+    const std::array<soul::time::FrameGraph::NodeId, 3> roots{slow, left, right};
+    builder.add("Join", [&] { ++runs; }, roots);
+    auto graph = builder.compile(scheduler);
+
+    // Nodes still queued when the workers exit run on the thread that discards them.
+    graph.dispatch();
+    started.wait(false);
+    scheduler->stop();
+    graph.wait();
+    EXPECT_EQ(runs.load(), 4);
+
+    // Later replays are dropped by the scheduler and run inline.
+    graph.execute();
+    EXPECT_EQ(runs.load(), 8);
+    graph.dispatch();
+}
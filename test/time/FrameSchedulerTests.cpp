@@ -5,7 +5,10 @@
 #include <chrono>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "Async/Task.h"
@@ -37,16 +40,16 @@ TEST(FrameScheduler, ExecutesDependenciesInTopologicalOrder) {
     const std::array<soul::async::TaskToken, 1> childDeps{root.token};
     auto childA = frameScheduler.schedule("childA", MakePushTask(order, orderGuard, 2), childDeps);
     const std::array<soul::async::TaskToken, 1> grandChildDeps{childA.token};
-    auto childB = frameScheduler.schedule("childB",
-                                          [&]() -> soul::async::Task<void> {
-                                              {
-                                                  std::lock_guard lock(orderGuard);
-                                                  order.push_back(3);
-                                              }
-                                              completion.set_value();
-                                              co_return;
-                                          }(),
-                                          grandChildDeps);
+    // The closure must outlive the coroutine, which refers to its captures by reference.
+    auto pushLast = [&]() -> soul::async::Task<void> {
+        {
+            std::lock_guard lock(orderGuard);
+            order.push_back(3);
+        }
+        completion.set_value();
+        co_return;
+    };
+    auto childB = frameScheduler.schedule("childB", pushLast(), grandChildDeps);
 
     const auto status = completionFuture.wait_for(std::chrono::milliseconds(100));
     ASSERT_EQ(status, std::future_status::ready)
@@ -70,20 +73,22 @@ TEST(FrameScheduler, DelayedTasksRespectDelayOrdering) {
     std::promise<void> completion;
     auto completionFuture = completion.get_future();
 
-    auto first = frameScheduler.schedule("immediate", [&]() -> soul::async::Task<void> {
+    auto markFirst = [&]() -> soul::async::Task<void> {
         firstRan.store(true, std::memory_order_release);
         co_return;
-    }());
+    };
+    auto recordOrder = [&]() -> soul::async::Task<void> {
+        observedOrder.store(firstRan.load(std::memory_order_acquire), std::memory_order_release);
+        completion.set_value();
+        co_return;
+    };
+
+    auto first = frameScheduler.schedule("immediate", markFirst());
 
     const std::array<soul::async::TaskToken, 1> dependencyTokens{first.token};
     auto delayed = frameScheduler.schedule_after(std::chrono::milliseconds(10),
                                                  "delayed",
-                                                 [&]() -> soul::async::Task<void> {
-                                                     observedOrder.store(firstRan.load(std::memory_order_acquire),
-                                                                         std::memory_order_release);
-                                                     completion.set_value();
-                                                     co_return;
-                                                 }(),
+                                                 recordOrder(),
                                                  dependencyTokens);
 
     const auto delayedStatus = completionFuture.wait_for(std::chrono::milliseconds(250));
@@ -96,3 +101,190 @@ TEST(FrameScheduler, DelayedTasksRespectDelayOrdering) {
     EXPECT_TRUE(firstRan.load(std::memory_order_acquire));
     EXPECT_TRUE(observedOrder.load(std::memory_order_acquire));
 }
+
+TEST(FrameScheduler, DelayedTasksDoNotOccupyAWorker) {
+    using Clock = soul::async::TaskScheduler::Clock;
+    constexpr auto kDelay = std::chrono::milliseconds(200);
+
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    soul::time::FrameScheduler frameScheduler(scheduler);
+
+    const auto start = Clock::now();
+    std::atomic<Clock::duration::rep> delayedElapsed{0};
+    std::atomic<Clock::duration::rep> immediateElapsed{0};
+
+    auto runDelayed = [&]() -> soul::async::Task<void> {
+        delayedElapsed.store((Clock::now() - start).count());
+        co_return;
+    };
+    auto runImmediate = [&]() -> soul::async::Task<void> {
+        immediateElapsed.store((Clock::now() - start).count());
+        co_return;
+    };
+
+    // With a single worker, a sleeping delay would hold back everything scheduled after it.
+    auto delayed = frameScheduler.schedule_after(kDelay, "delayed", runDelayed());
+    auto immediate = frameScheduler.schedule("immediate", runImmediate());
+
+    frameScheduler.wait_for_all();
+
+    EXPECT_LT(Clock::duration(immediateElapsed.load()), kDelay);
+    EXPECT_GE(Clock::duration(delayedElapsed.load()), kDelay);
+}
+
+TEST(FrameScheduler, ReschedulingANameSupersedesThePendingJob) {
+    using Clock = soul::async::TaskScheduler::Clock;
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    soul::time::FrameScheduler frameScheduler(scheduler);
+
+    std::atomic_int staleRuns{0};
+    std::atomic_int freshRuns{0};
+    auto runStale = [&]() -> soul::async::Task<void> {
+        staleRuns.fetch_add(1);
+        co_return;
+    };
+    auto runFresh = [&]() -> soul::async::Task<void> {
+        freshRuns.fetch_add(1);
+        co_return;
+    };
+    auto runAfter = [&]() -> soul::async::Task<void> {
+        co_return;
+    };
+
+    const auto start = Clock::now();
+    auto stale = frameScheduler.schedule_after(std::chrono::seconds(30), "physics", runStale());
+    const std::array<soul::async::TaskToken, 1> staleDeps{stale.token};
+    auto dependent = frameScheduler.schedule("after", runAfter(), staleDeps);
+    auto fresh = frameScheduler.schedule("physics", runFresh());
+
+    // The superseded job is skipped at once, so neither it nor its dependent waits out the delay.
+    frameScheduler.wait_for_all();
+    EXPECT_LT(Clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(staleRuns.load(), 0);
+    EXPECT_EQ(freshRuns.load(), 1);
+    EXPECT_FALSE(frameScheduler.cancel("unknown"));
+}
+
+TEST(FrameScheduler, GraphRecordingIsOffByDefault) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    soul::time::FrameScheduler frameScheduler(scheduler);
+    EXPECT_FALSE(frameScheduler.graph_recording());
+
+    std::vector<int> buffer;
+    std::mutex guard;
+    auto first = frameScheduler.schedule("first", MakePushTask(buffer, guard, 1));
+    const std::array<soul::async::TaskToken, 1> deps{first.token};
+    auto second = frameScheduler.schedule("second", MakePushTask(buffer, guard, 2), deps);
+    frameScheduler.wait_for_all();
+    EXPECT_EQ(buffer, (std::vector<int>{1, 2}));
+    EXPECT_TRUE(frameScheduler.snapshot().nodes.empty());
+
+    // Frames still advance while nothing is recorded.
+    frameScheduler.set_graph_recording(true);
+    auto third = frameScheduler.schedule("third", MakePushTask(buffer, guard, 3));
+    frameScheduler.wait_for_all();
+    const auto graph = frameScheduler.snapshot();
+    EXPECT_EQ(graph.frame, 1u);
+    ASSERT_EQ(graph.nodes.size(), 1u);
+    EXPECT_EQ(graph.nodes[0].name, "third");
+}
+
+TEST(FrameScheduler, SnapshotRecordsEdgesTimingAndCriticalPath) {
+    using State = soul::time::FrameScheduler::NodeState;
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(2);
+    soul::time::FrameScheduler frameScheduler(scheduler);
+    frameScheduler.set_graph_recording(true);
+
+    auto slow = []() -> soul::async::Task<void> {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        co_return;
+    };
+    auto fast = []() -> soul::async::Task<void> {
+        co_return;
+    };
+
+    auto load = frameScheduler.schedule("load", slow());
+    auto parse = frameScheduler.schedule("parse", fast());
+    const std::array<soul::async::TaskToken, 2> buildDeps{load.token, parse.token};
+    auto build = frameScheduler.schedule("build", fast(), buildDeps);
+    frameScheduler.wait_for_all();
+
+    const auto graph = frameScheduler.snapshot();
+    EXPECT_EQ(graph.frame, 0u);
+    ASSERT_EQ(graph.nodes.size(), 3u);
+    EXPECT_EQ(graph.nodes[2].name, "build");
+    EXPECT_EQ(graph.nodes[2].dependencies, (std::vector<std::uint32_t>{0, 1}));
+    for (const auto& node : graph.nodes) {
+        EXPECT_EQ(node.state, State::Completed) << node.name;
+        EXPECT_LE(node.scheduledAt, node.startedAt) << node.name;
+        EXPECT_LE(node.startedAt, node.finishedAt) << node.name;
+    }
+    EXPECT_GE(graph.nodes[0].duration(), std::chrono::milliseconds(5));
+    EXPECT_GE(graph.nodes[2].startedAt, graph.nodes[0].finishedAt);
+    EXPECT_EQ(graph.critical_path(), (std::vector<std::uint32_t>{0, 2}));
+    EXPECT_EQ(graph.makespan(), graph.nodes[2].finishedAt);
+}
+
+TEST(FrameScheduler, EachWaitForAllClosesAFrameGraph) {
+    using State = soul::time::FrameScheduler::NodeState;
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    soul::time::FrameScheduler frameScheduler(scheduler);
+    frameScheduler.set_graph_recording(true);
+
+    auto noop = []() -> soul::async::Task<void> {
+        co_return;
+    };
+
+    auto first = frameScheduler.schedule("first", noop());
+    frameScheduler.wait_for_all();
+    EXPECT_EQ(frameScheduler.snapshot().nodes.size(), 1u);
+
+    // Tokens from the previous frame still gate the job but are not edges of the new graph.
+    const std::array<soul::async::TaskToken, 1> previous{first.token};
+    auto second = frameScheduler.schedule("second", noop(), previous);
+    auto delayed = frameScheduler.schedule_after(std::chrono::seconds(30), "delayed", noop());
+    EXPECT_TRUE(frameScheduler.cancel("delayed"));
+    frameScheduler.wait_for_all();
+
+    const auto graph = frameScheduler.snapshot();
+    EXPECT_EQ(graph.frame, 1u);
+    ASSERT_EQ(graph.nodes.size(), 2u);
+    EXPECT_TRUE(graph.nodes[0].dependencies.empty());
+    EXPECT_EQ(graph.nodes[0].state, State::Completed);
+    EXPECT_EQ(graph.nodes[1].name, "delayed");
+    EXPECT_EQ(graph.nodes[1].state, State::Cancelled);
+    EXPECT_EQ(graph.nodes[1].duration(), std::chrono::nanoseconds{0});
+    EXPECT_EQ(graph.critical_path(), (std::vector<std::uint32_t>{0}));
+}
+
+TEST(FrameScheduler, EndFrameRecyclesNamesAndReleasesTaskStates) {
+    auto scheduler = std::make_shared<soul::async::TaskScheduler>(1);
+    soul::time::FrameScheduler frameScheduler(scheduler);
+    frameScheduler.set_graph_recording(true);
+
+    auto noop = []() -> soul::async::Task<void> {
+        co_return;
+    };
+
+    std::weak_ptr<soul::async::detail::TaskStateBase> firstState;
+    for (std::uint64_t frame = 0; frame < 50; ++frame) {
+        EXPECT_EQ(frameScheduler.begin_frame(), frame);
+        // Names unique per frame used to pile up forever.
+        auto handle = frameScheduler.schedule("load " + std::to_string(frame), noop());
+        const std::array<soul::async::TaskToken, 1> dependencies{handle.token};
+        auto after = frameScheduler.schedule("after", noop(), dependencies);
+        if (frame == 0) {
+            firstState = handle.token.state();
+        }
+        EXPECT_EQ(frameScheduler.tracked_jobs(), 2u);
+        frameScheduler.end_frame();
+
+        EXPECT_EQ(frameScheduler.tracked_jobs(), 0u);
+        EXPECT_FALSE(frameScheduler.cancel("after"));
+        const auto graph = frameScheduler.snapshot();
+        EXPECT_EQ(graph.frame, frame);
+        ASSERT_EQ(graph.nodes.size(), 2u);
+        EXPECT_EQ(graph.nodes[1].dependencies, (std::vector<std::uint32_t>{0}));
+    }
+    EXPECT_TRUE(firstState.expired());
+}
@@ -1,88 +1,148 @@
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <thread>
 #include <vector>
 
 #include "Async/Task.h"
+#include "Async/Tracer.h"
 #include "time/FrameScheduler.h"
 
 namespace soul::tools {
 
 /**
- * @brief Simple utility that exports FrameScheduler task dependencies as Graphviz DOT.
- * @details This prototype demonstrates how token relationships can be traced to visualize
- *          execution DAGs. In a production setting, the scheduler would expose snapshot APIs
- *          for live instrumentation; for now we accept a set of (name, token, dependencies) tuples.
+ * @brief Exports a `FrameScheduler` graph snapshot as Graphviz DOT.
+ * @details Nodes are labelled with their measured duration; the critical path (the chain of
+ *          dependencies that finished last) is highlighted, along with the edges between its nodes.
  */
 class DagVisualizer {
 public:
-    struct TaskNode {
-        std::string name;
-        soul::async::TaskToken token;
-        std::vector<soul::async::TaskToken> dependencies;
-    };
-
-    void add_node(std::string name, soul::async::TaskToken token,
-                  std::vector<soul::async::TaskToken> dependencies = {}) {
-        m_nodes.push_back({std::move(name), std::move(token), std::move(dependencies)});
-    }
+    using Snapshot = soul::time::FrameScheduler::GraphSnapshot;
+
+    static void write_dot(std::ostream& out, const Snapshot& graph) {
+        using Micros = std::chrono::duration<double, std::micro>;
+
+        const auto criticalPath = graph.critical_path();
+        std::vector<bool> critical(graph.nodes.size(), false);
+        for (const auto id : criticalPath) {
+            critical[id] = true;
+        }
 
-    void write_dot(std::ostream& out) const {
         out << "digraph FrameSchedulerDAG {\n";
         out << "  rankdir=TB;\n";
+        out << "  label=\"frame " << graph.frame << " (" << std::fixed << std::setprecision(1)
+            << Micros(graph.makespan()).count() << " us)\";\n";
         out << "  node [shape=box, style=filled, fillcolor=lightblue];\n\n";
 
-        // Build reverse lookup: token -> name
-        std::unordered_map<const void*, std::string> tokenToName;
-        for (const auto& node : m_nodes) {
-            if (node.token.valid()) {
-                tokenToName[node.token.state().get()] = node.name;
+        for (const auto& node : graph.nodes) {
+            out << "  n" << node.id << " [label=\"" << escape(node.name) << "\\n";
+            switch (node.state) {
+            case soul::time::FrameScheduler::NodeState::Completed:
+                out << Micros(node.duration()).count() << " us";
+                break;
+            case soul::time::FrameScheduler::NodeState::Running:
+                out << "running";
+                break;
+            case soul::time::FrameScheduler::NodeState::Pending:
+                out << "pending";
+                break;
+            case soul::time::FrameScheduler::NodeState::Cancelled:
+                out << "cancelled";
+                break;
             }
-        }
-
-        // Emit nodes
-        for (const auto& node : m_nodes) {
-            out << "  \"" << node.name << "\";\n";
+            out << "\"";
+            if (critical[node.id]) {
+                out << ", fillcolor=salmon";
+            } else if (node.state == soul::time::FrameScheduler::NodeState::Cancelled) {
+                out << ", fillcolor=lightgray";
+            }
+            out << "];\n";
         }
 
         out << "\n";
 
-        // Emit edges
-        for (const auto& node : m_nodes) {
-            for (const auto& dep : node.dependencies) {
-                if (!dep.valid()) continue;
-                auto it = tokenToName.find(dep.state().get());
-                if (it != tokenToName.end()) {
-                    out << "  \"" << it->second << "\" -> \"" << node.name << "\";\n";
+        for (const auto& node : graph.nodes) {
+            for (const auto dependency : node.dependencies) {
+                out << "  n" << dependency << " -> n" << node.id;
+                if (critical[dependency] && critical[node.id]) {
+                    out << " [color=red, penwidth=2]";
                 }
+                out << ";\n";
             }
         }
 
         out << "}\n";
     }
 
-    void write_dot_file(const std::string& path) const {
+    static void write_dot_file(const std::string& path, const Snapshot& graph) {
         std::ofstream file(path);
         if (!file) {
             throw std::runtime_error("Failed to open output file: " + path);
         }
-        write_dot(file);
+        write_dot(file, graph);
     }
 
 private:
-    std::vector<TaskNode> m_nodes;
+    static std::string escape(const std::string& text) {
+        std::string escaped;
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
 };
 
+/**
+ * @brief Prints a per-worker summary of a `TaskScheduler::metrics()` snapshot.
+ */
+inline void write_scheduler_metrics(std::ostream& out, const soul::async::SchedulerMetrics& metrics) {
+    using std::chrono::duration_cast;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    out << "Scheduler queue depth: " << metrics.queue_depth() << " (injected " << metrics.injectedDepth
+        << ", deadline " << metrics.deadlineDepth << ")\n";
+    if (!metrics.enabled) {
+        out << "Worker counters unavailable: build with SOULLIB_ENABLE_SCHEDULER_METRICS=ON.\n";
+        return;
+    }
+
+    out << std::fixed << std::setprecision(1);
+    for (std::size_t i = 0; i < metrics.workers.size(); ++i) {
+        const auto& worker = metrics.workers[i];
+        out << "  worker " << i << ": jobs " << worker.jobsExecuted << ", steals " << worker.steals
+            << ", wake-ups " << worker.wakeUps << ", spin hits " << worker.spinHits << ", busy " << duration_cast<Micros>(worker.busyTime).count()
+            << " us, idle " << duration_cast<Micros>(worker.idleTime).count() << " us, queued "
+            << worker.queueDepth << "\n";
+    }
+    const auto latency = metrics.queue_latency();
+    const auto execution = metrics.execution_time();
+    out << "  enqueue->start p50 <= " << duration_cast<Micros>(latency.percentile(0.5)).count()
+        << " us, p99 <= " << duration_cast<Micros>(latency.percentile(0.99)).count() << " us\n";
+    out << "  execution      p50 <= " << duration_cast<Micros>(execution.percentile(0.5)).count()
+        << " us, p99 <= " << duration_cast<Micros>(execution.percentile(0.99)).count() << " us\n";
+}
+
 } // namespace soul::tools
 
 namespace {
 
 void print_usage(const char* progName) {
-    std::cout << "Usage: " << progName << " <output.dot>\n";
+    std::cout << "Usage: " << progName << " <output.dot> [trace.json]\n";
     std::cout << "  Generates a Graphviz DOT file visualizing a sample FrameScheduler DAG.\n";
+    std::cout << "  With trace.json, also records the frame as Chrome trace-event JSON (open in ui.perfetto.dev).\n";
+}
+
+// Stands in for real frame work; blocking the worker keeps the sample self-contained.
+soul::async::Task<void> run_step(const char* message, std::chrono::microseconds work) {
+    std::cout << message << "\n";
+    std::this_thread::sleep_for(work);
+    co_return;
 }
 
 } // namespace
@@ -93,60 +153,64 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    using namespace std::chrono_literals;
+
     const std::string outputPath = argv[1];
+    const std::string tracePath = argc > 2 ? argv[2] : "";
 
     try {
         // Example scenario: Build a mock DAG with several interdependent tasks
         auto scheduler = std::make_shared<soul::async::TaskScheduler>();
         scheduler->run();
+        if (!tracePath.empty()) {
+            scheduler->set_tracer(std::make_shared<soul::async::Tracer>());
+            scheduler->tracer()->start();
+        }
 
         soul::time::FrameScheduler frame(scheduler);
-        soul::tools::DagVisualizer visualizer;
+        frame.set_graph_recording(true);
 
         // Task A: independent
-        auto handleA = frame.schedule("LoadTextures", scheduler->run_async([]() {
-            std::cout << "[Task A] Loading textures...\n";
-        }));
-        visualizer.add_node("LoadTextures", handleA.token, {});
+        auto handleA = frame.schedule("LoadTextures", run_step("[Task A] Loading textures...", 3ms));
 
         // Task B: independent
-        auto handleB = frame.schedule("LoadModels", scheduler->run_async([]() {
-            std::cout << "[Task B] Loading models...\n";
-        }));
-        visualizer.add_node("LoadModels", handleB.token, {});
+        auto handleB = frame.schedule("LoadModels", run_step("[Task B] Loading models...", 5ms));
 
         // Task C: depends on A and B
         std::vector<soul::async::TaskToken> depsC = {handleA.token, handleB.token};
         auto handleC = frame.schedule("BuildMaterials",
-            scheduler->run_async([]() {
-                std::cout << "[Task C] Building materials from textures + models...\n";
-            }),
+            run_step("[Task C] Building materials from textures + models...", 2ms),
             depsC
         );
-        visualizer.add_node("BuildMaterials", handleC.token, depsC);
 
         // Task D: depends on C
         std::vector<soul::async::TaskToken> depsD = {handleC.token};
         auto handleD = frame.schedule("UploadToGPU",
-            scheduler->run_async([]() {
-                std::cout << "[Task D] Uploading resources to GPU...\n";
-            }),
+            run_step("[Task D] Uploading resources to GPU...", 1ms),
             depsD
         );
-        visualizer.add_node("UploadToGPU", handleD.token, depsD);
 
         // Task E: parallel to the above chain
-        auto handleE = frame.schedule("InitializeAudio", scheduler->run_async([]() {
-            std::cout << "[Task E] Initializing audio subsystem...\n";
-        }));
-        visualizer.add_node("InitializeAudio", handleE.token, {});
+        auto handleE = frame.schedule("InitializeAudio", run_step("[Task E] Initializing audio subsystem...", 4ms));
 
         frame.wait_for_all();
+        const auto graph = frame.snapshot();
+        soul::tools::write_scheduler_metrics(std::cout, scheduler->metrics());
         scheduler->stop();
 
-        visualizer.write_dot_file(outputPath);
+        std::cout << "Critical path:";
+        for (const auto id : graph.critical_path()) {
+            std::cout << " " << graph.nodes[id].name;
+        }
+        std::cout << "\n";
+
+        soul::tools::DagVisualizer::write_dot_file(outputPath, graph);
         std::cout << "DAG exported to: " << outputPath << "\n";
         std::cout << "Render with: dot -Tpng " << outputPath << " -o dag.png\n";
+        if (!tracePath.empty()) {
+            scheduler->tracer()->write_chrome_trace_file(tracePath);
+            std::cout << "Trace exported to: " << tracePath << "\n";
+        }
 
         return 0;
     } catch (const std::exception& ex) {